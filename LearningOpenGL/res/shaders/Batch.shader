@@ -0,0 +1,61 @@
+#shader vertex
+#version 330 core
+
+layout(location = 0) in vec4 position;
+layout(location = 1) in vec2 texCoord;
+layout(location = 2) in vec4 color;
+layout(location = 3) in float texIndex;
+
+out vec2 v_TexCoord;
+out vec4 v_Color;
+flat out int v_TexIndex;
+
+// quads are batched in world space so only the camera is applied here
+uniform mat4 u_ViewProj;
+
+void main()
+{
+	gl_Position = u_ViewProj * position;
+	v_TexCoord = texCoord;
+	v_Color = color;
+	v_TexIndex = int(texIndex);
+}
+
+
+#shader fragment
+#version 330 core
+
+layout(location = 0) out vec4 color;
+
+in vec2 v_TexCoord;
+in vec4 v_Color;
+flat in int v_TexIndex;
+
+// MAX_TEXTURE_SLOTS is defined by the Shader class (16, 24 or 32)
+uniform sampler2D u_Textures[MAX_TEXTURE_SLOTS];
+
+// Sampler arrays can only be indexed by constants in GLSL 3.30, so every slot is its own case.
+// Gradients are taken outside the switch, where every fragment of a 2x2 block is still active.
+#define SLOT(n) case n: texColor = textureGrad(u_Textures[n], v_TexCoord, dx, dy); break;
+
+void main()
+{
+	vec2 dx = dFdx(v_TexCoord);
+	vec2 dy = dFdy(v_TexCoord);
+
+	vec4 texColor = vec4(1.0);
+	switch (v_TexIndex)
+	{
+		SLOT(0) SLOT(1) SLOT(2) SLOT(3) SLOT(4) SLOT(5) SLOT(6) SLOT(7)
+		SLOT(8) SLOT(9) SLOT(10) SLOT(11) SLOT(12) SLOT(13) SLOT(14) SLOT(15)
+#if MAX_TEXTURE_SLOTS > 16
+		SLOT(16) SLOT(17) SLOT(18) SLOT(19) SLOT(20) SLOT(21) SLOT(22) SLOT(23)
+#endif
+#if MAX_TEXTURE_SLOTS > 24
+		SLOT(24) SLOT(25) SLOT(26) SLOT(27) SLOT(28) SLOT(29) SLOT(30) SLOT(31)
+#endif
+	}
+
+	//samples texture at texture coordinatates and tints it by the quad color
+	color = texColor * v_Color;
+}
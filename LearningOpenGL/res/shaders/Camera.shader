@@ -0,0 +1,39 @@
+#shader vertex
+#version 330 core
+
+layout(location = 0) in vec4 position;
+layout(location = 1) in vec2 texCoord;
+
+out vec2 v_TexCoord;
+
+// shared by every shader, uploaded once per frame
+layout(std140) uniform Camera
+{
+	mat4 u_Projection;
+	mat4 u_View;
+	mat4 u_ViewProjection;
+};
+
+// the only per object data
+uniform mat4 u_Model;
+
+void main()
+{
+	gl_Position = u_ViewProjection * u_Model * position;
+	v_TexCoord = texCoord;
+}
+
+
+#shader fragment
+#version 330 core
+
+layout(location = 0) out vec4 color;
+
+in vec2 v_TexCoord;
+
+uniform sampler2D u_Texture;
+
+void main()
+{
+	color = texture(u_Texture, v_TexCoord);
+}
@@ -0,0 +1,50 @@
+#shader compute
+#version 430 core
+
+// must match GPUCuller::GroupSize
+layout(local_size_x = 64) in;
+
+struct Bounds
+{
+	vec4 Min;
+	vec4 Max;
+};
+
+// same layout as DrawElementsIndirectCommand
+struct DrawCommand
+{
+	uint Count;
+	uint InstanceCount;
+	uint FirstIndex;
+	int BaseVertex;
+	uint BaseInstance;
+};
+
+layout(std430, binding = 0) readonly buffer BoundsBuffer { Bounds b_Bounds[]; };
+layout(std430, binding = 1) writeonly buffer VisibleBuffer { uint b_Visible[]; };
+layout(std430, binding = 2) buffer CommandBuffer { DrawCommand b_Command; };
+
+// frustum planes pointing inwards
+uniform vec4 u_Planes[6];
+uniform int u_InstanceCount;
+
+void main()
+{
+	uint index = gl_GlobalInvocationID.x;
+	if (index >= uint(u_InstanceCount))
+		return;
+
+	vec3 minimum = b_Bounds[index].Min.xyz;
+	vec3 maximum = b_Bounds[index].Max.xyz;
+	for (int i = 0; i < 6; i++)
+	{
+		// the corner furthest along the plane normal is the last one to leave the frustum
+		vec3 corner = mix(minimum, maximum, greaterThanEqual(u_Planes[i].xyz, vec3(0.0)));
+		if (dot(u_Planes[i].xyz, corner) + u_Planes[i].w < 0.0)
+			return;
+	}
+
+	// Survivors are packed to the front of the list, the counter doubles as the instance count
+	uint slot = atomicAdd(b_Command.InstanceCount, 1u);
+	b_Visible[slot] = index;
+}
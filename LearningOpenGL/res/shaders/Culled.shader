@@ -0,0 +1,41 @@
+#shader vertex
+#version 430 core
+
+layout(location = 0) in vec4 position;
+layout(location = 1) in vec2 texCoord;
+
+out vec2 v_TexCoord;
+
+layout(std140) uniform Camera
+{
+	mat4 u_Projection;
+	mat4 u_View;
+	mat4 u_ViewProjection;
+};
+
+// written by res/shaders/Cull.shader, one entry per drawn instance
+layout(std430, binding = 1) readonly buffer VisibleBuffer { uint b_Visible[]; };
+// model matrix of every instance, visible or not
+layout(std430, binding = 3) readonly buffer InstanceBuffer { mat4 b_Models[]; };
+
+void main()
+{
+	mat4 model = b_Models[b_Visible[gl_InstanceID]];
+	gl_Position = u_ViewProjection * model * position;
+	v_TexCoord = texCoord;
+}
+
+
+#shader fragment
+#version 430 core
+
+layout(location = 0) out vec4 color;
+
+in vec2 v_TexCoord;
+
+uniform sampler2D u_Texture;
+
+void main()
+{
+	color = texture(u_Texture, v_TexCoord);
+}
@@ -0,0 +1,36 @@
+#shader vertex
+#version 330 core
+
+layout(location = 0) in vec4 position;
+// base instance of the draw (see DrawIndirectBuffer::AttachDrawID)
+layout(location = 1) in float drawID;
+
+out vec4 v_Color;
+
+uniform mat4 u_ViewProj;
+uniform int u_Columns;
+uniform float u_CellSize;
+
+void main()
+{
+	// per draw data is derived from the draw ID: a cell of the grid and a color
+	int id = int(drawID);
+	vec2 cell = vec2(id % u_Columns, id / u_Columns);
+	vec2 center = (cell + 0.5) * u_CellSize;
+
+	gl_Position = u_ViewProj * vec4(center + position.xy * u_CellSize * 0.4, 0.0, 1.0);
+	v_Color = vec4(fract(vec3(0.13, 0.37, 0.71) * float(id + 1)), 1.0);
+}
+
+
+#shader fragment
+#version 330 core
+
+layout(location = 0) out vec4 color;
+
+in vec4 v_Color;
+
+void main()
+{
+	color = v_Color;
+}
\ No newline at end of file
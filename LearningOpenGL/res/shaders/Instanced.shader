@@ -0,0 +1,36 @@
+#shader vertex
+#version 330 core
+
+// per vertex: the shared quad mesh
+layout(location = 0) in vec4 position;
+layout(location = 1) in vec2 texCoord;
+
+// per instance: model matrix (one column per attribute) and texture rectangle (u0, v0, u1, v1)
+layout(location = 2) in mat4 model;
+layout(location = 6) in vec4 texRect;
+
+out vec2 v_TexCoord;
+
+uniform mat4 u_ViewProj;
+
+void main()
+{
+	gl_Position = u_ViewProj * model * position;
+	v_TexCoord = mix(texRect.xy, texRect.zw, texCoord);
+}
+
+
+#shader fragment
+#version 330 core
+
+layout(location = 0) out vec4 color;
+
+in vec2 v_TexCoord;
+
+uniform sampler2D u_Texture;
+
+void main()
+{
+	//samples texture at texture coordinatates
+	color = texture(u_Texture, v_TexCoord);
+}
\ No newline at end of file
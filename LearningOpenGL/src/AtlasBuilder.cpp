@@ -0,0 +1,133 @@
+#include "AtlasBuilder.h"
+#include "ParallelFor.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <thread>
+
+#include "stb_image/stb_image.h"
+
+// imgui_draw.cpp compiles its own static copy, so this one is static as well
+#define STBRP_STATIC
+#define STB_RECT_PACK_IMPLEMENTATION
+#include "imgui/stb_rect_pack.h"
+
+namespace {
+	struct Image
+	{
+		unsigned char* Pixels;
+		int Width, Height;
+	};
+}
+
+AtlasBuilder::AtlasBuilder(int maxSize, int padding)
+	: m_MaxSize(maxSize), m_Padding(padding)
+{
+}
+
+unsigned int AtlasBuilder::Add(const std::string& path)
+{
+	m_Paths.push_back(path);
+	return (unsigned int)m_Paths.size() - 1;
+}
+
+bool AtlasBuilder::Build(unsigned int threadCount)
+{
+	const unsigned int count = (unsigned int)m_Paths.size();
+	if (threadCount == 0)
+		threadCount = std::max(1u, std::thread::hardware_concurrency());
+
+	int maxTextureSize;
+	GLCall(glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxTextureSize));
+	const int size = std::min(m_MaxSize, maxTextureSize);
+
+	m_Atlases.clear();
+	m_Regions.assign(count, { InvalidAtlas, glm::vec4(0.0f), 0, 0 });
+
+	// Decoding is most of the work. The flip setting is global in stb_image,
+	// so it is set before the threads start, the same way Texture sets it
+	std::vector<Image> images(count);
+	stbi_set_flip_vertically_on_load(1);
+	ParallelFor(count, threadCount, [&](unsigned int i)
+	{
+		int bpp;
+		Image& image = images[i];
+		image.Pixels = stbi_load(m_Paths[i].c_str(), &image.Width, &image.Height, &bpp, 4);
+		if (!image.Pixels)
+			image.Width = image.Height = 0;
+	});
+
+	bool complete = true;
+	std::vector<stbrp_rect> pending;
+	for (unsigned int i = 0; i < count; i++)
+	{
+		const Image& image = images[i];
+		if (!image.Pixels || image.Width + 2 * m_Padding > size || image.Height + 2 * m_Padding > size)
+		{
+			std::cout << "[AtlasBuilder] Skipping " << m_Paths[i] << ": " <<
+				(image.Pixels ? "larger than an atlas" : "failed to load") << std::endl;
+			complete = false;
+			continue;
+		}
+
+		stbrp_rect rect = {};
+		rect.id = (int)i;
+		rect.w = (stbrp_coord)(image.Width + 2 * m_Padding);
+		rect.h = (stbrp_coord)(image.Height + 2 * m_Padding);
+		pending.push_back(rect);
+	}
+
+	// Fill one atlas after another with whatever did not fit into the previous ones
+	std::vector<stbrp_node> nodes(size);
+	std::vector<std::vector<unsigned char>> pages;
+	while (!pending.empty())
+	{
+		stbrp_context context;
+		stbrp_init_target(&context, size, size, nodes.data(), (int)nodes.size());
+		stbrp_pack_rects(&context, pending.data(), (int)pending.size());
+
+		unsigned int atlas = (unsigned int)pages.size();
+		std::vector<stbrp_rect> packed, rest;
+		for (const stbrp_rect& rect : pending)
+			(rect.was_packed ? packed : rest).push_back(rect);
+
+		// every rect fits an empty atlas on its own, this only guards against a packer failure
+		if (packed.empty())
+		{
+			complete = false;
+			break;
+		}
+
+		pages.emplace_back((size_t)size * size * 4, (unsigned char)0);
+		unsigned char* page = pages.back().data();
+
+		// Images never overlap, so every thread copies its own rows
+		ParallelFor((unsigned int)packed.size(), threadCount, [&](unsigned int p)
+		{
+			const stbrp_rect& rect = packed[p];
+			const Image& image = images[rect.id];
+			int x = rect.x + m_Padding;
+			int y = rect.y + m_Padding;
+			for (int row = 0; row < image.Height; row++)
+				std::memcpy(page + ((size_t)(y + row) * size + x) * 4, image.Pixels + (size_t)row * image.Width * 4, (size_t)image.Width * 4);
+
+			// both are stored bottom row first, so v grows with y just like in the image
+			m_Regions[rect.id] = { atlas, glm::vec4(x, y, x + image.Width, y + image.Height) / (float)size, image.Width, image.Height };
+		});
+
+		pending.swap(rest);
+	}
+
+	for (Image& image : images)
+	{
+		if (image.Pixels)
+			stbi_image_free(image.Pixels);
+	}
+
+	// OpenGL calls stay on this thread
+	for (const std::vector<unsigned char>& page : pages)
+		m_Atlases.push_back(std::make_unique<Texture>(size, size, page.data()));
+
+	return complete;
+}
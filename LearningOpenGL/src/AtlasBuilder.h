@@ -0,0 +1,53 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "glm/glm.hpp"
+
+#include "Texture.h"
+
+// Where one image ended up after packing
+struct AtlasRegion
+{
+	// index of the atlas texture, InvalidAtlas if the image could not be loaded or packed
+	unsigned int Atlas;
+	// (u0, v0, u1, v1), the same form Renderer::DrawQuad and SpriteStore take
+	glm::vec4 TexRect;
+	int Width, Height;
+};
+
+// Packs many images into as few large textures as possible at load time, so sprites using
+// different images can share one texture and one batch. Images are decoded and copied into
+// place on several threads; only the final upload happens on the calling (OpenGL) thread.
+class AtlasBuilder
+{
+public:
+	static const unsigned int InvalidAtlas = 0xFFFFFFFF;
+
+private:
+	std::vector<std::string> m_Paths;
+	int m_MaxSize;
+	// empty pixels around every image so linear filtering does not pick up its neighbours
+	int m_Padding;
+
+	std::vector<AtlasRegion> m_Regions;
+	std::vector<std::unique_ptr<Texture>> m_Atlases;
+
+public:
+	// Atlases are at most maxSize x maxSize, further limited by GL_MAX_TEXTURE_SIZE
+	AtlasBuilder(int maxSize = 4096, int padding = 1);
+
+	// Queues an image and returns its index for GetRegion
+	unsigned int Add(const std::string& path);
+
+	// Loads, packs and uploads every queued image, replacing the atlases of an earlier Build.
+	// threadCount 0 uses every hardware thread. Returns false if an image was left out
+	bool Build(unsigned int threadCount = 0);
+
+	inline const AtlasRegion& GetRegion(unsigned int image) const { return m_Regions[image]; }
+	inline const Texture& GetAtlas(unsigned int atlas) const { return *m_Atlases[atlas]; }
+	inline unsigned int GetAtlasCount() const { return (unsigned int)m_Atlases.size(); }
+	inline unsigned int GetImageCount() const { return (unsigned int)m_Paths.size(); }
+};
\ No newline at end of file
@@ -0,0 +1,73 @@
+#include "BufferUsage.h"
+
+#include "Renderer.h"
+
+#include <cstring>
+
+unsigned int GetGLUsage(BufferUsage usage)
+{
+	switch (usage)
+	{
+	case BufferUsage::Static:	return GL_STATIC_DRAW;
+	case BufferUsage::Dynamic:	return GL_DYNAMIC_DRAW;
+	case BufferUsage::Stream:	return GL_STREAM_DRAW;
+	}
+	ASSERT(false);
+	return 0;
+}
+
+void UpdateBuffer(unsigned int target, const void* data, unsigned int size, unsigned int offset,
+	unsigned int capacity, BufferUsage usage, BufferUpdate update)
+{
+	ASSERT(offset + size <= capacity);
+
+	switch (update)
+	{
+	case BufferUpdate::SubData:
+		GLCall(glBufferSubData(target, offset, size, data));
+		break;
+	case BufferUpdate::Orphan:
+		// a whole new buffer can take the data straight away
+		if (offset == 0 && size == capacity)
+		{
+			GLCall(glBufferData(target, capacity, data, GetGLUsage(usage)));
+		}
+		else
+		{
+			GLCall(glBufferData(target, capacity, nullptr, GetGLUsage(usage)));
+			GLCall(glBufferSubData(target, offset, size, data));
+		}
+		break;
+	case BufferUpdate::UnsynchronizedMap:
+	{
+		void* mapped = MapBuffer(target, size, offset, capacity, update);
+		memcpy(mapped, data, size);
+		GLCall(glUnmapBuffer(target));
+		break;
+	}
+	}
+}
+
+void* MapBuffer(unsigned int target, unsigned int size, unsigned int offset,
+	unsigned int capacity, BufferUpdate update)
+{
+	ASSERT(offset + size <= capacity);
+
+	// The old contents of the range are never read back, so the driver does not have to keep them
+	GLbitfield access = GL_MAP_WRITE_BIT;
+	switch (update)
+	{
+	case BufferUpdate::SubData:
+		access |= GL_MAP_INVALIDATE_RANGE_BIT;
+		break;
+	case BufferUpdate::Orphan:
+		access |= GL_MAP_INVALIDATE_BUFFER_BIT;
+		break;
+	case BufferUpdate::UnsynchronizedMap:
+		access |= GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT;
+		break;
+	}
+
+	GLCall(void* data = glMapBufferRange(target, offset, size, access));
+	return data;
+}
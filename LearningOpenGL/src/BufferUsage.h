@@ -0,0 +1,33 @@
+#pragma once
+
+// How often the contents of a buffer change, picks the usage hint OpenGL allocates it with
+enum class BufferUsage
+{
+	// written once, drawn many times (GL_STATIC_DRAW)
+	Static,
+	// rewritten now and then, drawn many times (GL_DYNAMIC_DRAW)
+	Dynamic,
+	// rewritten about every time it is drawn (GL_STREAM_DRAW)
+	Stream
+};
+
+// How new contents reach a buffer the GPU may still be reading from
+enum class BufferUpdate
+{
+	// glBufferSubData: the driver copies the data aside or waits until the GPU is done with the old contents
+	SubData,
+	// Reallocates the storage first so the GPU keeps reading the old one. Everything outside the written range is lost
+	Orphan,
+	// Writes straight into the storage through glMapBufferRange without any synchronisation,
+	// the caller has to be sure the GPU no longer reads that range
+	UnsynchronizedMap
+};
+
+unsigned int GetGLUsage(BufferUsage usage);
+
+// Writes size bytes at offset into the buffer bound to target, whose storage is capacity bytes
+void UpdateBuffer(unsigned int target, const void* data, unsigned int size, unsigned int offset,
+	unsigned int capacity, BufferUsage usage, BufferUpdate update);
+// Maps size bytes at offset of the buffer bound to target for writing, synchronised the way update says
+void* MapBuffer(unsigned int target, unsigned int size, unsigned int offset,
+	unsigned int capacity, BufferUpdate update);
\ No newline at end of file
@@ -0,0 +1,200 @@
+#include "Camera.h"
+
+#include "glm/gtc/matrix_transform.hpp"
+
+Camera::Camera()
+	: m_Position(0.0f), m_Projection(1.0f), m_View(1.0f), m_ViewProjection(1.0f), m_Frustum(),
+	m_ProjectionDirty(true), m_ViewDirty(true), m_ViewProjectionDirty(true), m_FrustumDirty(true), m_Version(0)
+{
+}
+
+void Camera::SetPosition(const glm::vec3& position)
+{
+	if (position == m_Position)
+		return;
+
+	m_Position = position;
+	InvalidateView();
+}
+
+const glm::mat4& Camera::GetProjection() const
+{
+	Update();
+	return m_Projection;
+}
+
+const glm::mat4& Camera::GetView() const
+{
+	Update();
+	return m_View;
+}
+
+const glm::mat4& Camera::GetViewProjection() const
+{
+	Update();
+	return m_ViewProjection;
+}
+
+const Frustum& Camera::GetFrustum() const
+{
+	Update();
+	if (m_FrustumDirty)
+	{
+		m_Frustum = Frustum::FromMatrix(m_ViewProjection);
+		m_FrustumDirty = false;
+	}
+	return m_Frustum;
+}
+
+CameraUniforms Camera::GetUniforms() const
+{
+	Update();
+	return { m_Projection, m_View, m_ViewProjection };
+}
+
+unsigned int Camera::GetVersion() const
+{
+	Update();
+	return m_Version;
+}
+
+void Camera::Refresh() const
+{
+	// GetFrustum runs Update first
+	GetFrustum();
+}
+
+void Camera::InvalidateProjection()
+{
+	m_ProjectionDirty = true;
+	m_ViewProjectionDirty = true;
+}
+
+void Camera::InvalidateView()
+{
+	m_ViewDirty = true;
+	m_ViewProjectionDirty = true;
+}
+
+void Camera::Update() const
+{
+	if (!m_ViewProjectionDirty)
+		return;
+
+	if (m_ProjectionDirty)
+	{
+		m_Projection = ComputeProjection();
+		m_ProjectionDirty = false;
+	}
+
+	if (m_ViewDirty)
+	{
+		// The view moves the world the opposite way of the camera
+		glm::mat4 transform = glm::translate(glm::mat4(1.0f), m_Position) * ComputeRotation();
+		m_View = glm::inverse(transform);
+		m_ViewDirty = false;
+	}
+
+	m_ViewProjection = m_Projection * m_View;
+	m_ViewProjectionDirty = false;
+	m_FrustumDirty = true;
+	m_Version++;
+}
+
+OrthographicCamera::OrthographicCamera(float width, float height)
+	: m_Width(width), m_Height(height), m_Zoom(1.0f), m_Rotation(0.0f)
+{
+}
+
+void OrthographicCamera::SetViewport(float width, float height)
+{
+	if (width == m_Width && height == m_Height)
+		return;
+
+	m_Width = width;
+	m_Height = height;
+	InvalidateProjection();
+}
+
+void OrthographicCamera::SetZoom(float zoom)
+{
+	if (zoom == m_Zoom)
+		return;
+
+	m_Zoom = zoom;
+	InvalidateProjection();
+}
+
+void OrthographicCamera::SetRotation(float degrees)
+{
+	if (degrees == m_Rotation)
+		return;
+
+	m_Rotation = degrees;
+	InvalidateView();
+}
+
+glm::mat4 OrthographicCamera::ComputeProjection() const
+{
+	return glm::ortho(0.0f, m_Width / m_Zoom, 0.0f, m_Height / m_Zoom, -1.0f, 1.0f);
+}
+
+glm::mat4 OrthographicCamera::ComputeRotation() const
+{
+	return glm::rotate(glm::mat4(1.0f), glm::radians(m_Rotation), glm::vec3(0.0f, 0.0f, 1.0f));
+}
+
+PerspectiveCamera::PerspectiveCamera(float width, float height, float fieldOfView, float nearClip, float farClip)
+	: m_Width(width), m_Height(height), m_FieldOfView(fieldOfView), m_Near(nearClip), m_Far(farClip), m_Pitch(0.0f), m_Yaw(0.0f)
+{
+}
+
+void PerspectiveCamera::SetViewport(float width, float height)
+{
+	if (width == m_Width && height == m_Height)
+		return;
+
+	m_Width = width;
+	m_Height = height;
+	InvalidateProjection();
+}
+
+void PerspectiveCamera::SetFieldOfView(float degrees)
+{
+	if (degrees == m_FieldOfView)
+		return;
+
+	m_FieldOfView = degrees;
+	InvalidateProjection();
+}
+
+void PerspectiveCamera::SetClip(float nearClip, float farClip)
+{
+	if (nearClip == m_Near && farClip == m_Far)
+		return;
+
+	m_Near = nearClip;
+	m_Far = farClip;
+	InvalidateProjection();
+}
+
+void PerspectiveCamera::SetRotation(float pitch, float yaw)
+{
+	if (pitch == m_Pitch && yaw == m_Yaw)
+		return;
+
+	m_Pitch = pitch;
+	m_Yaw = yaw;
+	InvalidateView();
+}
+
+glm::mat4 PerspectiveCamera::ComputeProjection() const
+{
+	return glm::perspective(glm::radians(m_FieldOfView), m_Width / m_Height, m_Near, m_Far);
+}
+
+glm::mat4 PerspectiveCamera::ComputeRotation() const
+{
+	glm::mat4 yaw = glm::rotate(glm::mat4(1.0f), glm::radians(m_Yaw), glm::vec3(0.0f, 1.0f, 0.0f));
+	return glm::rotate(yaw, glm::radians(m_Pitch), glm::vec3(1.0f, 0.0f, 0.0f));
+}
@@ -0,0 +1,113 @@
+#pragma once
+
+#include "glm/glm.hpp"
+
+#include "Culling.h"
+#include "UniformBuffer.h"
+
+// Owns the projection and view of a scene. The matrices (and the frustum built from them)
+// are only recomputed when a setter actually changed something, and only when next asked for,
+// so reading them every frame or for every object costs nothing.
+class Camera
+{
+private:
+	glm::vec3 m_Position;
+
+	// cached results, rebuilt lazily by the getters
+	mutable glm::mat4 m_Projection;
+	mutable glm::mat4 m_View;
+	mutable glm::mat4 m_ViewProjection;
+	mutable Frustum m_Frustum;
+	mutable bool m_ProjectionDirty;
+	mutable bool m_ViewDirty;
+	mutable bool m_ViewProjectionDirty;
+	mutable bool m_FrustumDirty;
+
+	// bumped whenever the matrices change, lets users skip re-uploading them
+	mutable unsigned int m_Version;
+
+public:
+	Camera();
+	virtual ~Camera() {}
+
+	void SetPosition(const glm::vec3& position);
+	inline const glm::vec3& GetPosition() const { return m_Position; }
+
+	const glm::mat4& GetProjection() const;
+	const glm::mat4& GetView() const;
+	const glm::mat4& GetViewProjection() const;
+	// view volume for CullBoxes, in world space
+	const Frustum& GetFrustum() const;
+
+	// The matrices laid out for the std140 "Camera" uniform block
+	CameraUniforms GetUniforms() const;
+	unsigned int GetVersion() const;
+
+	// Rebuilds every cached value (and bumps the version) now instead of in the next getter.
+	// Call it before copying a camera: a copy that rebuilds itself leaves the original stale
+	void Refresh() const;
+
+protected:
+	// derived cameras call these from their setters when a value really changed
+	void InvalidateProjection();
+	void InvalidateView();
+
+	virtual glm::mat4 ComputeProjection() const = 0;
+	// camera rotation around its position, the translation is added by Camera
+	virtual glm::mat4 ComputeRotation() const = 0;
+
+private:
+	void Update() const;
+};
+
+// 2D camera with the origin at the bottom left of the viewport, one unit per pixel at zoom 1
+class OrthographicCamera : public Camera
+{
+private:
+	float m_Width, m_Height;
+	float m_Zoom;
+	// around the z axis, in degrees
+	float m_Rotation;
+
+public:
+	OrthographicCamera(float width, float height);
+
+	void SetViewport(float width, float height);
+	void SetZoom(float zoom);
+	void SetRotation(float degrees);
+
+	inline float GetZoom() const { return m_Zoom; }
+	inline float GetRotation() const { return m_Rotation; }
+
+protected:
+	glm::mat4 ComputeProjection() const override;
+	glm::mat4 ComputeRotation() const override;
+};
+
+// 3D camera looking down -z when pitch and yaw are zero
+class PerspectiveCamera : public Camera
+{
+private:
+	float m_Width, m_Height;
+	// vertical, in degrees
+	float m_FieldOfView;
+	float m_Near, m_Far;
+	// in degrees
+	float m_Pitch, m_Yaw;
+
+public:
+	PerspectiveCamera(float width, float height, float fieldOfView = 45.0f, float nearClip = 0.1f, float farClip = 1000.0f);
+
+	void SetViewport(float width, float height);
+	void SetFieldOfView(float degrees);
+	void SetClip(float nearClip, float farClip);
+	void SetRotation(float pitch, float yaw);
+
+	inline float GetFieldOfView() const { return m_FieldOfView; }
+	inline float GetPitch() const { return m_Pitch; }
+	inline float GetYaw() const { return m_Yaw; }
+
+protected:
+	glm::mat4 ComputeProjection() const override;
+	glm::mat4 ComputeRotation() const override;
+};
\ No newline at end of file
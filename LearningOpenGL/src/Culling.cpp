@@ -0,0 +1,156 @@
+#include "Culling.h"
+#include "CullingAVX.h"
+
+#include <emmintrin.h>
+#include <intrin.h>
+
+void BoundsSoA::Add(const glm::vec3& min, const glm::vec3& max)
+{
+	m_MinX.push_back(min.x);
+	m_MinY.push_back(min.y);
+	m_MinZ.push_back(min.z);
+	m_MaxX.push_back(max.x);
+	m_MaxY.push_back(max.y);
+	m_MaxZ.push_back(max.z);
+}
+
+void BoundsSoA::Clear()
+{
+	m_MinX.clear(); m_MinY.clear(); m_MinZ.clear();
+	m_MaxX.clear(); m_MaxY.clear(); m_MaxZ.clear();
+}
+
+void BoundsSoA::Reserve(unsigned int count)
+{
+	m_MinX.reserve(count); m_MinY.reserve(count); m_MinZ.reserve(count);
+	m_MaxX.reserve(count); m_MaxY.reserve(count); m_MaxZ.reserve(count);
+}
+
+Frustum Frustum::FromMatrix(const glm::mat4& viewProj)
+{
+	// Gribb/Hartmann: each clip plane is the last row of the matrix plus or minus another row
+	glm::vec4 row0(viewProj[0][0], viewProj[1][0], viewProj[2][0], viewProj[3][0]);
+	glm::vec4 row1(viewProj[0][1], viewProj[1][1], viewProj[2][1], viewProj[3][1]);
+	glm::vec4 row2(viewProj[0][2], viewProj[1][2], viewProj[2][2], viewProj[3][2]);
+	glm::vec4 row3(viewProj[0][3], viewProj[1][3], viewProj[2][3], viewProj[3][3]);
+
+	Frustum frustum;
+	frustum.Planes[0] = row3 + row0; // left
+	frustum.Planes[1] = row3 - row0; // right
+	frustum.Planes[2] = row3 + row1; // bottom
+	frustum.Planes[3] = row3 - row1; // top
+	frustum.Planes[4] = row3 + row2; // near
+	frustum.Planes[5] = row3 - row2; // far
+	return frustum;
+}
+
+namespace {
+	bool IsVisible(const CullPlane* planes, unsigned int i)
+	{
+		for (int p = 0; p < 6; p++)
+		{
+			const CullPlane& plane = planes[p];
+			float distance = plane.X * plane.CornerX[i] + plane.Y * plane.CornerY[i] + plane.Z * plane.CornerZ[i] + plane.W;
+			if (distance < 0.0f)
+				return false;
+		}
+		return true;
+	}
+
+	// The CPU has to support AVX and the OS has to save the YMM registers on a context switch
+	bool HasAVX()
+	{
+		int info[4];
+		__cpuid(info, 1);
+		bool osxsave = (info[2] & (1 << 27)) != 0;
+		bool avx = (info[2] & (1 << 28)) != 0;
+		if (!osxsave || !avx)
+			return false;
+
+		// XMM (bit 1) and YMM (bit 2) state enabled in XCR0
+		return (_xgetbv(0) & 6) == 6;
+	}
+
+	// Four boxes against one plane per instruction, up to the last whole group of four
+	unsigned int CullBoxesSSE(const CullPlane* planes, unsigned int count, unsigned int* visible)
+	{
+		__m128 planeX[6], planeY[6], planeZ[6], planeW[6];
+		for (int p = 0; p < 6; p++)
+		{
+			planeX[p] = _mm_set1_ps(planes[p].X);
+			planeY[p] = _mm_set1_ps(planes[p].Y);
+			planeZ[p] = _mm_set1_ps(planes[p].Z);
+			planeW[p] = _mm_set1_ps(planes[p].W);
+		}
+
+		unsigned int visibleCount = 0;
+		const __m128 zero = _mm_setzero_ps();
+		for (unsigned int i = 0; i + 4 <= count; i += 4)
+		{
+			__m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+			for (int p = 0; p < 6; p++)
+			{
+				__m128 distance = _mm_add_ps(
+					_mm_add_ps(_mm_mul_ps(planeX[p], _mm_loadu_ps(planes[p].CornerX + i)),
+						_mm_mul_ps(planeY[p], _mm_loadu_ps(planes[p].CornerY + i))),
+					_mm_add_ps(_mm_mul_ps(planeZ[p], _mm_loadu_ps(planes[p].CornerZ + i)), planeW[p]));
+				inside = _mm_and_ps(inside, _mm_cmpge_ps(distance, zero));
+			}
+
+			// one bit per box, written out as a compact list of indices
+			int mask = _mm_movemask_ps(inside);
+			while (mask)
+			{
+				unsigned int lane = 0;
+				while (!(mask & (1 << lane)))
+					lane++;
+				visible[visibleCount++] = i + lane;
+				mask &= mask - 1;
+			}
+		}
+		return visibleCount;
+	}
+}
+
+void CullBoxes(const Frustum& frustum, const BoundsSoA& bounds, std::vector<unsigned int>& visible)
+{
+	// checked once, the answer cannot change while the program runs
+	static const bool useAVX = HasAVX();
+
+	const unsigned int count = bounds.GetCount();
+	visible.resize(count);
+
+	// For each plane only the box corner furthest along its normal needs testing,
+	// so per plane every coordinate is read from either the min or the max array
+	CullPlane planes[6];
+	for (int p = 0; p < 6; p++)
+	{
+		const glm::vec4& plane = frustum.Planes[p];
+		planes[p] = {
+			plane.x, plane.y, plane.z, plane.w,
+			plane.x >= 0.0f ? bounds.GetMaxX() : bounds.GetMinX(),
+			plane.y >= 0.0f ? bounds.GetMaxY() : bounds.GetMinY(),
+			plane.z >= 0.0f ? bounds.GetMaxZ() : bounds.GetMinZ(),
+		};
+	}
+
+	unsigned int visibleCount, i;
+	if (useAVX)
+	{
+		visibleCount = CullBoxesAVX(planes, count, visible.data());
+		i = count & ~7u;
+	}
+	else
+	{
+		visibleCount = CullBoxesSSE(planes, count, visible.data());
+		i = count & ~3u;
+	}
+
+	// the boxes that do not fill a whole register
+	for (; i < count; i++)
+	{
+		if (IsVisible(planes, i))
+			visible[visibleCount++] = i;
+	}
+	visible.resize(visibleCount);
+}
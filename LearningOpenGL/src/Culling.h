@@ -0,0 +1,41 @@
+#pragma once
+
+#include <vector>
+
+#include "glm/glm.hpp"
+
+// Axis aligned boxes stored as one array per coordinate, so SIMD code can test
+// several boxes with each instruction
+class BoundsSoA
+{
+private:
+	std::vector<float> m_MinX, m_MinY, m_MinZ;
+	std::vector<float> m_MaxX, m_MaxY, m_MaxZ;
+
+public:
+	void Add(const glm::vec3& min, const glm::vec3& max);
+	void Clear();
+	void Reserve(unsigned int count);
+
+	inline unsigned int GetCount() const { return (unsigned int)m_MinX.size(); }
+
+	inline const float* GetMinX() const { return m_MinX.data(); }
+	inline const float* GetMinY() const { return m_MinY.data(); }
+	inline const float* GetMinZ() const { return m_MinZ.data(); }
+	inline const float* GetMaxX() const { return m_MaxX.data(); }
+	inline const float* GetMaxY() const { return m_MaxY.data(); }
+	inline const float* GetMaxZ() const { return m_MaxZ.data(); }
+};
+
+// The six planes of a view volume, pointing inwards (a point p is inside when dot(plane.xyz, p) + plane.w >= 0)
+struct Frustum
+{
+	glm::vec4 Planes[6];
+
+	// Works for orthographic and perspective projections alike
+	static Frustum FromMatrix(const glm::mat4& viewProj);
+};
+
+// Writes the indices of every box that is at least partly inside the frustum to visible.
+// Uses AVX (eight boxes at a time) when the CPU supports it, SSE (four at a time) otherwise.
+void CullBoxes(const Frustum& frustum, const BoundsSoA& bounds, std::vector<unsigned int>& visible);
\ No newline at end of file
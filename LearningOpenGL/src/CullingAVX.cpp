@@ -0,0 +1,47 @@
+#include "CullingAVX.h"
+
+#include <immintrin.h>
+
+// Everything in here may be VEX encoded, so nothing else (not even inline functions from
+// headers the rest of the program shares) belongs in this file
+
+unsigned int CullBoxesAVX(const CullPlane* planes, unsigned int count, unsigned int* visible)
+{
+	// Eight boxes against one plane per instruction
+	__m256 planeX[6], planeY[6], planeZ[6], planeW[6];
+	for (int p = 0; p < 6; p++)
+	{
+		planeX[p] = _mm256_set1_ps(planes[p].X);
+		planeY[p] = _mm256_set1_ps(planes[p].Y);
+		planeZ[p] = _mm256_set1_ps(planes[p].Z);
+		planeW[p] = _mm256_set1_ps(planes[p].W);
+	}
+
+	unsigned int visibleCount = 0;
+	const __m256 zero = _mm256_setzero_ps();
+	for (unsigned int i = 0; i + 8 <= count; i += 8)
+	{
+		__m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+		for (int p = 0; p < 6; p++)
+		{
+			__m256 distance = _mm256_add_ps(
+				_mm256_add_ps(_mm256_mul_ps(planeX[p], _mm256_loadu_ps(planes[p].CornerX + i)),
+					_mm256_mul_ps(planeY[p], _mm256_loadu_ps(planes[p].CornerY + i))),
+				_mm256_add_ps(_mm256_mul_ps(planeZ[p], _mm256_loadu_ps(planes[p].CornerZ + i)), planeW[p]));
+			inside = _mm256_and_ps(inside, _mm256_cmp_ps(distance, zero, _CMP_GE_OQ));
+		}
+
+		// one bit per box, written out as a compact list of indices
+		int mask = _mm256_movemask_ps(inside);
+		while (mask)
+		{
+			unsigned int lane = 0;
+			while (!(mask & (1 << lane)))
+				lane++;
+			visible[visibleCount++] = i + lane;
+			mask &= mask - 1;
+		}
+	}
+
+	return visibleCount;
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+// A frustum plane with the coordinate arrays of the box corner furthest along its normal
+struct CullPlane
+{
+	float X, Y, Z, W;
+	const float* CornerX;
+	const float* CornerY;
+	const float* CornerZ;
+};
+
+// The AVX half of CullBoxes, in its own file because only this one is built with /arch:AVX.
+// Tests boxes eight at a time up to the last whole group of eight, writes the indices of the
+// visible ones to visible and returns how many it wrote. Only call it after checking that the
+// CPU and the OS support AVX.
+unsigned int CullBoxesAVX(const CullPlane* planes, unsigned int count, unsigned int* visible);
\ No newline at end of file
@@ -0,0 +1,81 @@
+#include "DrawIndirectBuffer.h"
+
+#include "Renderer.h"
+#include "GLStateCache.h"
+#include "GLDeletionQueue.h"
+#include "VertexBufferLayout.h"
+
+DrawIndirectBuffer::DrawIndirectBuffer(unsigned int maxDraws)
+	: m_RendererID(0), m_MaxDraws(maxDraws), m_InstanceCount(0), m_DrawIDAttrib(-1)
+{
+	m_Commands.reserve(maxDraws);
+
+	if (IsMultiDrawSupported())
+	{
+		GLCall(glGenBuffers(1, &m_RendererID));
+		Bind();
+		GLCall(glBufferData(GL_DRAW_INDIRECT_BUFFER, maxDraws * sizeof(DrawElementsIndirectCommand), nullptr, GL_DYNAMIC_DRAW));
+	}
+}
+
+DrawIndirectBuffer::~DrawIndirectBuffer()
+{
+	GLDeletionQueue::Enqueue(GLObjectType::Buffer, m_RendererID);
+}
+
+bool DrawIndirectBuffer::IsMultiDrawSupported()
+{
+	return GLEW_VERSION_4_3 || GLEW_ARB_multi_draw_indirect;
+}
+
+unsigned int DrawIndirectBuffer::AddDraw(unsigned int count, unsigned int firstIndex, int baseVertex, unsigned int instanceCount)
+{
+	ASSERT(m_Commands.size() < m_MaxDraws);
+
+	// the draw ID buffer has one entry per instance of all draws together
+	ASSERT(!m_DrawIDBuffer || m_InstanceCount + instanceCount <= m_MaxDraws);
+
+	m_Commands.push_back({ count, instanceCount, firstIndex, baseVertex, m_InstanceCount });
+	m_InstanceCount += instanceCount;
+	return (unsigned int)m_Commands.size() - 1;
+}
+
+void DrawIndirectBuffer::Clear()
+{
+	m_Commands.clear();
+	m_InstanceCount = 0;
+}
+
+void DrawIndirectBuffer::Upload()
+{
+	if (!m_RendererID || m_Commands.empty())
+		return;
+
+	Bind();
+	GLCall(glBufferSubData(GL_DRAW_INDIRECT_BUFFER, 0, m_Commands.size() * sizeof(DrawElementsIndirectCommand), m_Commands.data()));
+}
+
+void DrawIndirectBuffer::AttachDrawID(VertexArray& va)
+{
+	// One ID per instance of every draw, the base instance picks where a draw starts
+	std::vector<float> ids(m_MaxDraws);
+	for (unsigned int i = 0; i < m_MaxDraws; i++)
+		ids[i] = (float)i;
+	m_DrawIDBuffer = std::make_unique<VertexBuffer>(ids.data(), m_MaxDraws * (unsigned int)sizeof(float));
+
+	VertexBufferLayout layout;
+	layout.Push<float>(1, 1);
+
+	m_DrawIDAttrib = (int)va.GetAttribCount();
+	va.AddBuffer(*m_DrawIDBuffer, layout);
+}
+
+void DrawIndirectBuffer::Bind() const
+{
+	GLStateCache::BindBuffer(GL_DRAW_INDIRECT_BUFFER, m_RendererID);
+}
+
+void DrawIndirectBuffer::Unbind() const
+{
+	GLStateCache::BindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+}
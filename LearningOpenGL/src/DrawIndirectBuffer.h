@@ -0,0 +1,63 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "VertexBuffer.h"
+
+class VertexArray;
+
+// Same layout OpenGL reads from GL_DRAW_INDIRECT_BUFFER for glMultiDrawElementsIndirect
+struct DrawElementsIndirectCommand
+{
+	unsigned int Count;
+	unsigned int InstanceCount;
+	unsigned int FirstIndex;
+	int BaseVertex;
+	unsigned int BaseInstance;
+};
+
+// Collects draws of meshes that share one vertex array and index buffer, so they can
+// all be submitted with a single glMultiDrawElementsIndirect.
+// Each draw gets its own base instance, which shaders can use to look up per-draw data
+// through the draw ID attribute (see AttachDrawID).
+class DrawIndirectBuffer
+{
+private:
+	// 0 when multi draw indirect is not supported and the commands stay on the CPU
+	unsigned int m_RendererID;
+	unsigned int m_MaxDraws;
+	std::vector<DrawElementsIndirectCommand> m_Commands;
+	// instances used by all draws so far, the base instance of the next draw
+	unsigned int m_InstanceCount;
+
+	// holds 0, 1, 2, ... so a per-instance attribute returns the base instance of each draw
+	std::unique_ptr<VertexBuffer> m_DrawIDBuffer;
+	int m_DrawIDAttrib;
+
+public:
+	DrawIndirectBuffer(unsigned int maxDraws);
+	~DrawIndirectBuffer();
+
+	// Adds a draw of count indices starting at firstIndex, returns the draw's index
+	unsigned int AddDraw(unsigned int count, unsigned int firstIndex, int baseVertex, unsigned int instanceCount = 1);
+	void Clear();
+
+	// Sends every command to the GPU in one upload
+	void Upload();
+
+	// Adds a float attribute to the vertex array (at its next free index) that holds the
+	// draw's base instance plus the instance index, for use as a draw ID in the shader.
+	// It has maxDraws entries, so instances of all draws together must fit in that
+	void AttachDrawID(VertexArray& va);
+
+	void Bind() const;
+	void Unbind() const;
+
+	inline const std::vector<DrawElementsIndirectCommand>& GetCommands() const { return m_Commands; }
+	inline unsigned int GetDrawCount() const { return (unsigned int)m_Commands.size(); }
+	inline int GetDrawIDAttrib() const { return m_DrawIDAttrib; }
+
+	// GL 4.3 or ARB_multi_draw_indirect, otherwise draws are looped on the CPU
+	static bool IsMultiDrawSupported();
+};
\ No newline at end of file
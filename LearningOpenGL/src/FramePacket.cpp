@@ -0,0 +1,72 @@
+#include "FramePacket.h"
+
+#include "imgui/imgui.h"
+#include "imgui/imgui_impl_glfw_gl3.h"
+
+FramePacket::FramePacket()
+	: m_ClearColor(0.0f, 0.0f, 0.0f, 1.0f), m_DepthTest(false), m_Synchronous(false),
+	m_ImGuiVtxCount(0), m_ImGuiIdxCount(0), m_ImGuiDisplaySize(0.0f), m_ImGuiFramebufferScale(1.0f)
+{
+}
+
+FramePacket::~FramePacket()
+{
+	Clear();
+}
+
+void FramePacket::Clear()
+{
+	m_ClearColor = glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+	m_DepthTest = false;
+	m_Commands.clear();
+	m_Callbacks.clear();
+	m_Synchronous = false;
+
+	for (ImDrawList*& list : m_ImGuiLists)
+		IM_DELETE(list);
+	m_ImGuiLists.clear();
+	m_ImGuiVtxCount = m_ImGuiIdxCount = 0;
+}
+
+void FramePacket::Submit(const RenderCommand& command, unsigned int layer, float depth, bool transparent)
+{
+	m_Commands.push_back({ command, layer, depth, transparent });
+}
+
+void FramePacket::AddCallback(const std::function<void()>& callback)
+{
+	m_Callbacks.push_back(callback);
+}
+
+void FramePacket::SetImGuiDrawData(const ImDrawData* drawData)
+{
+	for (int i = 0; i < drawData->CmdListsCount; i++)
+		m_ImGuiLists.push_back(drawData->CmdLists[i]->CloneOutput());
+	m_ImGuiVtxCount = drawData->TotalVtxCount;
+	m_ImGuiIdxCount = drawData->TotalIdxCount;
+
+	const ImGuiIO& io = ImGui::GetIO();
+	m_ImGuiDisplaySize = glm::vec2(io.DisplaySize.x, io.DisplaySize.y);
+	m_ImGuiFramebufferScale = glm::vec2(io.DisplayFramebufferScale.x, io.DisplayFramebufferScale.y);
+}
+
+void FramePacket::RenderImGui() const
+{
+	if (m_ImGuiLists.empty())
+		return;
+
+	// Points at the copies, the clip rects get scaled in place but nothing else changes
+	ImDrawData drawData;
+	drawData.Valid = true;
+	drawData.CmdLists = const_cast<ImDrawList**>(m_ImGuiLists.data());
+	drawData.CmdListsCount = (int)m_ImGuiLists.size();
+	drawData.TotalVtxCount = m_ImGuiVtxCount;
+	drawData.TotalIdxCount = m_ImGuiIdxCount;
+
+	// the IO belongs to the main thread, so the sizes come from the packet
+	ImGui_ImplGlfwGL3_RenderDrawData(&drawData, ImVec2(m_ImGuiDisplaySize.x, m_ImGuiDisplaySize.y),
+		ImVec2(m_ImGuiFramebufferScale.x, m_ImGuiFramebufferScale.y));
+
+	// ImDrawData does not own the lists, they are freed by Clear
+	drawData.Clear();
+}
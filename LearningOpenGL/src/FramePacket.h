@@ -0,0 +1,98 @@
+#pragma once
+
+#include <functional>
+#include <vector>
+
+#include "glm/glm.hpp"
+
+#include "RenderQueue.h"
+
+struct ImDrawData;
+struct ImDrawList;
+
+// Everything the render thread needs to draw one frame. It is filled on the main
+// thread and not touched again until the render thread has finished drawing it.
+class FramePacket
+{
+public:
+	// a queued draw with the layer and depth it is sorted by
+	struct Command
+	{
+		RenderCommand Draw;
+		unsigned int Layer;
+		float Depth;
+		bool Transparent;
+	};
+
+private:
+	glm::vec4 m_ClearColor;
+	// the queued draws are depth tested against a cleared depth buffer
+	bool m_DepthTest;
+	std::vector<Command> m_Commands;
+	// GL work that is not a plain draw, run after the commands
+	std::vector<std::function<void()>> m_Callbacks;
+	// the main thread has to wait for this packet before it may update again
+	bool m_Synchronous;
+
+	// copies of the ImGui draw lists, the originals are rebuilt by the next ImGui frame
+	std::vector<ImDrawList*> m_ImGuiLists;
+	int m_ImGuiVtxCount, m_ImGuiIdxCount;
+	// copied from ImGui::GetIO(), which the next ImGui frame writes while this one is rendered
+	glm::vec2 m_ImGuiDisplaySize, m_ImGuiFramebufferScale;
+
+public:
+	FramePacket();
+	~FramePacket();
+
+	FramePacket(const FramePacket&) = delete;
+	FramePacket& operator=(const FramePacket&) = delete;
+
+	// Empties the packet for a new frame (main thread only, it frees ImGui memory)
+	void Clear();
+
+	inline void SetClearColor(const glm::vec4& color) { m_ClearColor = color; }
+	inline void SetDepthTest(bool enabled) { m_DepthTest = enabled; }
+	void Submit(const RenderCommand& command, unsigned int layer = 0, float depth = 0.0f, bool transparent = false);
+	void AddCallback(const std::function<void()>& callback);
+	inline void SetSynchronous() { m_Synchronous = true; }
+
+	// Copies the draw lists and display size of the ImGui frame just rendered (main thread only)
+	void SetImGuiDrawData(const ImDrawData* drawData);
+
+	inline const glm::vec4& GetClearColor() const { return m_ClearColor; }
+	inline bool IsDepthTest() const { return m_DepthTest; }
+	inline const std::vector<Command>& GetCommands() const { return m_Commands; }
+	inline const std::vector<std::function<void()>>& GetCallbacks() const { return m_Callbacks; }
+	inline bool IsSynchronous() const { return m_Synchronous; }
+
+	// Renders the copied ImGui lists with the current context
+	void RenderImGui() const;
+};
+
+// Data a test copies for the render thread instead of letting it read members the next update
+// changes. The main thread fills one copy per frame while the render thread may still draw the
+// other. A packet is finished before the one after next is recorded, so two copies are enough
+// as long as every recorded frame submits exactly once.
+template<typename T>
+class FrameSnapshot
+{
+private:
+	T m_Copies[2];
+	unsigned int m_Index;
+
+public:
+	FrameSnapshot()
+		: m_Index(0) {}
+
+	// the copy this frame fills, also what direct mode draws from
+	inline T& Get() { return m_Copies[m_Index]; }
+
+	// Makes the render thread call draw with the filled copy, the next Get returns the other one
+	template<typename Draw>
+	void Submit(FramePacket& packet, Draw draw)
+	{
+		const T& copy = m_Copies[m_Index];
+		m_Index ^= 1;
+		packet.AddCallback([&copy, draw]() { draw(copy); });
+	}
+};
\ No newline at end of file
@@ -0,0 +1,91 @@
+#include "GLDeletionQueue.h"
+
+#include "Renderer.h"
+#include "GLStateCache.h"
+
+std::mutex GLDeletionQueue::s_Mutex;
+std::vector<GLDeletionQueue::Entry> GLDeletionQueue::s_Pending;
+std::deque<GLDeletionQueue::Frame> GLDeletionQueue::s_Frames;
+
+void GLDeletionQueue::Enqueue(GLObjectType type, unsigned int id)
+{
+	if (id == 0)
+		return;
+
+	std::lock_guard<std::mutex> lock(s_Mutex);
+	s_Pending.push_back({ type, id });
+}
+
+void GLDeletionQueue::EndFrame()
+{
+	Frame frame;
+	{
+		std::lock_guard<std::mutex> lock(s_Mutex);
+		frame.Entries.swap(s_Pending);
+	}
+
+	// No fence needed for a frame that deleted nothing
+	if (!frame.Entries.empty())
+	{
+		GLCall(frame.Fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+		s_Frames.push_back(std::move(frame));
+	}
+
+	// Frames finish in order, so stop at the first one the GPU is still working on
+	while (!s_Frames.empty())
+	{
+		GLsync fence = (GLsync)s_Frames.front().Fence;
+		GLCall(GLenum status = glClientWaitSync(fence, 0, 0));
+		if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED)
+			break;
+
+		GLCall(glDeleteSync(fence));
+		Delete(s_Frames.front().Entries);
+		s_Frames.pop_front();
+	}
+}
+
+void GLDeletionQueue::Flush()
+{
+	GLCall(glFinish());
+
+	for (Frame& frame : s_Frames)
+	{
+		GLCall(glDeleteSync((GLsync)frame.Fence));
+		Delete(frame.Entries);
+	}
+	s_Frames.clear();
+
+	std::vector<Entry> pending;
+	{
+		std::lock_guard<std::mutex> lock(s_Mutex);
+		pending.swap(s_Pending);
+	}
+	Delete(pending);
+}
+
+void GLDeletionQueue::Delete(const std::vector<Entry>& entries)
+{
+	for (const Entry& entry : entries)
+	{
+		switch (entry.Type)
+		{
+		case GLObjectType::Buffer:
+			GLCall(glDeleteBuffers(1, &entry.ID));
+			GLStateCache::OnDeleteBuffer(entry.ID);
+			break;
+		case GLObjectType::VertexArray:
+			GLCall(glDeleteVertexArrays(1, &entry.ID));
+			GLStateCache::OnDeleteVertexArray(entry.ID);
+			break;
+		case GLObjectType::Texture:
+			GLCall(glDeleteTextures(1, &entry.ID));
+			GLStateCache::OnDeleteTexture(entry.ID);
+			break;
+		case GLObjectType::Program:
+			GLCall(glDeleteProgram(entry.ID));
+			GLStateCache::OnDeleteProgram(entry.ID);
+			break;
+		}
+	}
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <deque>
+#include <mutex>
+#include <vector>
+
+// The kinds of OpenGL object the queue knows how to delete
+enum class GLObjectType
+{
+	Buffer, VertexArray, Texture, Program
+};
+
+// Destructors hand their OpenGL names to this queue instead of deleting them straight away.
+// At the end of each frame the names handed in during it are put behind a fence, and they
+// are only deleted once the GPU has passed that fence. Deleting never stalls a frame,
+// and a name can be handed in from any thread.
+class GLDeletionQueue
+{
+private:
+	struct Entry
+	{
+		GLObjectType Type;
+		unsigned int ID;
+	};
+
+	// names handed in during one frame and the fence that frame ended with
+	struct Frame
+	{
+		void* Fence;
+		std::vector<Entry> Entries;
+	};
+
+	static std::mutex s_Mutex;
+	static std::vector<Entry> s_Pending;
+	// only touched on the thread that owns the context
+	static std::deque<Frame> s_Frames;
+
+public:
+	// Any thread: the object will be deleted once the GPU is done with the current frame
+	static void Enqueue(GLObjectType type, unsigned int id);
+
+	// Context thread, after the frame's last draw: fences this frame's names and deletes
+	// the names of every earlier frame the GPU has finished
+	static void EndFrame();
+
+	// Context thread: waits for the GPU and deletes everything, e.g. before the context goes away
+	static void Flush();
+
+private:
+	static void Delete(const std::vector<Entry>& entries);
+};
\ No newline at end of file
@@ -0,0 +1,154 @@
+#include "GLStateCache.h"
+
+#include "Renderer.h"
+
+// A new context starts with nothing bound
+unsigned int GLStateCache::s_Program = 0;
+unsigned int GLStateCache::s_VertexArray = 0;
+unsigned int GLStateCache::s_ArrayBuffer = 0;
+std::unordered_map<unsigned int, unsigned int> GLStateCache::s_ElementBuffers;
+unsigned int GLStateCache::s_ActiveTextureUnit = 0;
+unsigned int GLStateCache::s_Textures[GLStateCache::MaxTextureUnits] = {};
+StateCacheStats GLStateCache::s_Stats;
+
+void GLStateCache::BindProgram(unsigned int id)
+{
+	// a hit never reaches GLCall, so the thread is checked here too
+	ASSERT(GLIsContextThread());
+	if (s_Program == id)
+	{
+		s_Stats.Hits++;
+		return;
+	}
+
+	GLCall(glUseProgram(id));
+	s_Program = id;
+	s_Stats.Misses++;
+}
+
+void GLStateCache::BindVertexArray(unsigned int id)
+{
+	ASSERT(GLIsContextThread());
+	if (s_VertexArray == id)
+	{
+		s_Stats.Hits++;
+		return;
+	}
+
+	GLCall(glBindVertexArray(id));
+	s_VertexArray = id;
+	s_Stats.Misses++;
+}
+
+void GLStateCache::BindBuffer(unsigned int target, unsigned int id)
+{
+	ASSERT(GLIsContextThread());
+	// element buffers are remembered for whichever vertex array is bound now
+	unsigned int* bound;
+	if (target == GL_ELEMENT_ARRAY_BUFFER)
+	{
+		auto it = s_ElementBuffers.find(s_VertexArray);
+		if (it == s_ElementBuffers.end())
+			it = s_ElementBuffers.insert({ s_VertexArray, s_VertexArray == Unknown ? Unknown : 0 }).first;
+		bound = &it->second;
+	}
+	else if (target == GL_ARRAY_BUFFER)
+	{
+		bound = &s_ArrayBuffer;
+	}
+	else
+	{
+		GLCall(glBindBuffer(target, id));
+		s_Stats.Misses++;
+		return;
+	}
+
+	if (*bound == id)
+	{
+		s_Stats.Hits++;
+		return;
+	}
+
+	GLCall(glBindBuffer(target, id));
+	*bound = id;
+	s_Stats.Misses++;
+}
+
+void GLStateCache::BindTexture(unsigned int slot, unsigned int id)
+{
+	ASSERT(GLIsContextThread());
+	if (slot < MaxTextureUnits && s_Textures[slot] == id)
+	{
+		s_Stats.Hits++;
+		return;
+	}
+
+	// selects texture slot before binding
+	if (s_ActiveTextureUnit != slot)
+	{
+		GLCall(glActiveTexture(GL_TEXTURE0 + slot));
+		s_ActiveTextureUnit = slot;
+	}
+	GLCall(glBindTexture(GL_TEXTURE_2D, id));
+
+	if (slot < MaxTextureUnits)
+		s_Textures[slot] = id;
+	s_Stats.Misses++;
+}
+
+void GLStateCache::UnbindTexture()
+{
+	if (s_ActiveTextureUnit == Unknown)
+	{
+		GLCall(glBindTexture(GL_TEXTURE_2D, 0));
+		s_Stats.Misses++;
+		return;
+	}
+	BindTexture(s_ActiveTextureUnit, 0);
+}
+
+void GLStateCache::OnDeleteProgram(unsigned int /*id*/)
+{
+	// A program that is in use stays in use until another one is bound, and its
+	// name is not reused before that, so the cache is still right
+}
+
+void GLStateCache::OnDeleteVertexArray(unsigned int id)
+{
+	if (s_VertexArray == id)
+		s_VertexArray = 0;
+	s_ElementBuffers.erase(id);
+}
+
+void GLStateCache::OnDeleteBuffer(unsigned int id)
+{
+	if (s_ArrayBuffer == id)
+		s_ArrayBuffer = 0;
+
+	// the name may come back for a different buffer, so no vertex array may keep it
+	for (auto& elementBuffer : s_ElementBuffers)
+	{
+		if (elementBuffer.second == id)
+			elementBuffer.second = elementBuffer.first == s_VertexArray ? 0 : Unknown;
+	}
+}
+
+void GLStateCache::OnDeleteTexture(unsigned int id)
+{
+	for (unsigned int slot = 0; slot < MaxTextureUnits; slot++)
+	{
+		if (s_Textures[slot] == id)
+			s_Textures[slot] = 0;
+	}
+}
+
+void GLStateCache::Invalidate()
+{
+	s_Program = Unknown;
+	s_VertexArray = Unknown;
+	s_ArrayBuffer = Unknown;
+	s_ElementBuffers.clear();
+	s_ActiveTextureUnit = Unknown;
+	for (unsigned int slot = 0; slot < MaxTextureUnits; slot++)
+		s_Textures[slot] = Unknown;
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <unordered_map>
+
+// Counts of binds that were skipped (hits) and binds that reached OpenGL (misses)
+struct StateCacheStats
+{
+	unsigned int Hits = 0;
+	unsigned int Misses = 0;
+};
+
+// Remembers what is bound in the OpenGL context so binding an object that is
+// already bound costs nothing, not even the GLCall error polling.
+// Every bind and delete of programs, vertex arrays, buffers and textures must go
+// through here, otherwise the cache no longer matches the context.
+// There is only one set of state, so it assumes a single OpenGL context and may
+// only be used on the thread that context is current on.
+class GLStateCache
+{
+public:
+	// texture units tracked by the cache, higher units are always passed to OpenGL
+	static const unsigned int MaxTextureUnits = 32;
+
+	static void BindProgram(unsigned int id);
+	static void BindVertexArray(unsigned int id);
+	// GL_ARRAY_BUFFER and GL_ELEMENT_ARRAY_BUFFER are cached, other targets are always passed to OpenGL
+	static void BindBuffer(unsigned int target, unsigned int id);
+	// binds a GL_TEXTURE_2D to a texture unit, only changing the active unit when needed
+	static void BindTexture(unsigned int slot, unsigned int id);
+	// binds no texture to the active unit
+	static void UnbindTexture();
+
+	// OpenGL unbinds deleted objects and may hand their names out again,
+	// so the cache has to forget them too
+	static void OnDeleteProgram(unsigned int id);
+	static void OnDeleteVertexArray(unsigned int id);
+	static void OnDeleteBuffer(unsigned int id);
+	static void OnDeleteTexture(unsigned int id);
+
+	// Forget everything, e.g. after code outside these classes changed bindings
+	static void Invalidate();
+
+	static const StateCacheStats& GetStats() { return s_Stats; }
+	static void ResetStats() { s_Stats = StateCacheStats(); }
+
+private:
+	// a name that never matches, so the next bind always reaches OpenGL
+	static const unsigned int Unknown = 0xFFFFFFFF;
+
+	static unsigned int s_Program;
+	static unsigned int s_VertexArray;
+	static unsigned int s_ArrayBuffer;
+	// the element buffer binding is part of the vertex array, so it is kept per vertex array
+	static std::unordered_map<unsigned int, unsigned int> s_ElementBuffers;
+	static unsigned int s_ActiveTextureUnit;
+	static unsigned int s_Textures[MaxTextureUnits];
+
+	static StateCacheStats s_Stats;
+};
\ No newline at end of file
@@ -0,0 +1,76 @@
+#include "GPUCuller.h"
+
+#include "Renderer.h"
+#include "GLStateCache.h"
+
+bool GPUCuller::IsSupported()
+{
+	return Shader::IsComputeSupported();
+}
+
+GPUCuller::GPUCuller(unsigned int maxInstances)
+	: m_MaxInstances(maxInstances), m_InstanceCount(0)
+{
+	m_Shader = std::make_unique<Shader>("res/shaders/Cull.shader");
+	m_Bounds = std::make_unique<ShaderStorageBuffer>(nullptr, maxInstances * 2 * sizeof(glm::vec4));
+	m_Visible = std::make_unique<ShaderStorageBuffer>(nullptr, maxInstances * sizeof(unsigned int));
+	m_Command = std::make_unique<ShaderStorageBuffer>(nullptr, sizeof(DrawElementsIndirectCommand));
+}
+
+void GPUCuller::SetBounds(const BoundsSoA& bounds)
+{
+	m_InstanceCount = bounds.GetCount() < m_MaxInstances ? bounds.GetCount() : m_MaxInstances;
+
+	// std430 has no vec3 arrays without padding, so every box is two vec4
+	m_Upload.resize(m_InstanceCount * 2);
+	for (unsigned int i = 0; i < m_InstanceCount; i++)
+	{
+		m_Upload[i * 2 + 0] = glm::vec4(bounds.GetMinX()[i], bounds.GetMinY()[i], bounds.GetMinZ()[i], 1.0f);
+		m_Upload[i * 2 + 1] = glm::vec4(bounds.GetMaxX()[i], bounds.GetMaxY()[i], bounds.GetMaxZ()[i], 1.0f);
+	}
+
+	if (m_InstanceCount > 0)
+		m_Bounds->SetSubData(m_Upload.data(), (unsigned int)(m_Upload.size() * sizeof(glm::vec4)));
+}
+
+void GPUCuller::Cull(const Frustum& frustum, unsigned int indexCount)
+{
+	// The compute shader counts the instances up from zero
+	DrawElementsIndirectCommand command = { indexCount, 0, 0, 0, 0 };
+	m_Command->SetSubData(&command, sizeof(DrawElementsIndirectCommand));
+
+	m_Shader->Bind();
+	for (int i = 0; i < 6; i++)
+	{
+		const glm::vec4& plane = frustum.Planes[i];
+		m_Shader->SetUniform4f("u_Planes[" + std::to_string(i) + "]", plane.x, plane.y, plane.z, plane.w);
+	}
+	m_Shader->SetUniform1i("u_InstanceCount", (int)m_InstanceCount);
+
+	m_Bounds->BindBase(BoundsBinding);
+	m_Visible->BindBase(VisibleBinding);
+	m_Command->BindBase(CommandBinding);
+
+	unsigned int groups = (m_InstanceCount + GroupSize - 1) / GroupSize;
+	if (groups > 0)
+	{
+		GLCall(glDispatchCompute(groups, 1, 1));
+	}
+
+	// The draw reads the command as indirect arguments and the visible list from a shader
+	GLCall(glMemoryBarrier(GL_COMMAND_BARRIER_BIT | GL_SHADER_STORAGE_BARRIER_BIT));
+}
+
+void GPUCuller::BindForDraw() const
+{
+	m_Visible->BindBase(VisibleBinding);
+	GLStateCache::BindBuffer(GL_DRAW_INDIRECT_BUFFER, m_Command->GetRendererID());
+}
+
+unsigned int GPUCuller::ReadVisibleCount() const
+{
+	DrawElementsIndirectCommand command;
+	GLCall(glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT));
+	m_Command->GetSubData(&command, sizeof(DrawElementsIndirectCommand));
+	return command.InstanceCount;
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "glm/glm.hpp"
+
+#include "Shader.h"
+#include "ShaderStorageBuffer.h"
+#include "Culling.h"
+
+// Frustum culling on the GPU (GL 4.3). A compute pass (res/shaders/Cull.shader) tests every
+// instance's box and appends the survivors to a visible list, counting them straight into an
+// indirect draw command. Renderer::DrawCulled then draws that command, so visibility never
+// travels back to the CPU. The vertex shader finds its instance as b_Visible[gl_InstanceID].
+class GPUCuller
+{
+public:
+	// buffer block bindings shared with the shaders
+	static const unsigned int BoundsBinding = 0;
+	static const unsigned int VisibleBinding = 1;
+	static const unsigned int CommandBinding = 2;
+	// first binding free for the instance data of the draw shader
+	static const unsigned int InstanceBinding = 3;
+
+	// local_size_x of the compute shader
+	static const unsigned int GroupSize = 64;
+
+private:
+	std::unique_ptr<Shader> m_Shader;
+	// per instance (min, max) pairs, the visible instance indices, one DrawElementsIndirectCommand
+	std::unique_ptr<ShaderStorageBuffer> m_Bounds;
+	std::unique_ptr<ShaderStorageBuffer> m_Visible;
+	std::unique_ptr<ShaderStorageBuffer> m_Command;
+
+	unsigned int m_MaxInstances;
+	unsigned int m_InstanceCount;
+
+	// bounds rearranged for upload, kept to avoid reallocating
+	std::vector<glm::vec4> m_Upload;
+
+public:
+	static bool IsSupported();
+
+	GPUCuller(unsigned int maxInstances);
+
+	// Uploads the boxes of every instance, only needed when they move
+	void SetBounds(const BoundsSoA& bounds);
+
+	// Culls all instances against frustum. The draw command gets indexCount indices per instance
+	void Cull(const Frustum& frustum, unsigned int indexCount);
+
+	// Binds the visible list for the vertex shader and the command as GL_DRAW_INDIRECT_BUFFER
+	void BindForDraw() const;
+
+	// Reads the number of survivors back. Stalls until the GPU has culled, so only for statistics
+	unsigned int ReadVisibleCount() const;
+
+	inline unsigned int GetInstanceCount() const { return m_InstanceCount; }
+};
\ No newline at end of file
@@ -1,26 +1,132 @@
 #include "IndexBuffer.h"
 
 #include "Renderer.h"
+#include "GLStateCache.h"
+#include "GLDeletionQueue.h"
 
-IndexBuffer::IndexBuffer(const unsigned int* data, unsigned int count)
-	: m_Count(count)
+IndexBuffer::IndexBuffer(const unsigned int* data, unsigned int count, BufferUsage usage, bool allowBytes)
+	: m_Count(count), m_Usage(usage), m_Type(ChooseType(data, count, allowBytes)), m_AllowBytes(allowBytes)
 {
+	std::vector<unsigned char> scratch;
+	const void* indices = Convert(data, count, scratch);
+
 	GLCall(glGenBuffers(1, &m_RendererID));
-	GLCall(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_RendererID));
-	GLCall(glBufferData(GL_ELEMENT_ARRAY_BUFFER, count * sizeof(unsigned int), data, GL_STATIC_DRAW));
+	Bind();
+	GLCall(glBufferData(GL_ELEMENT_ARRAY_BUFFER, count * GetTypeSize(), indices, GetGLUsage(usage)));
 }
 
 IndexBuffer::~IndexBuffer()
 {
-	GLCall(glDeleteBuffers(1, &m_RendererID))
+	// deleted once the GPU has finished the frames that may still use it
+	GLDeletionQueue::Enqueue(GLObjectType::Buffer, m_RendererID);
 }
 
 void IndexBuffer::Bind() const
 {
-	GLCall(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_RendererID));
+	GLStateCache::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_RendererID);
 }
 
 void IndexBuffer::Unbind() const
 {
-	GLCall(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0));
+	GLStateCache::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+}
+
+unsigned int IndexBuffer::GetTypeSize() const
+{
+	switch (m_Type)
+	{
+	case GL_UNSIGNED_BYTE:	return 1;
+	case GL_UNSIGNED_SHORT:	return 2;
+	}
+	return 4;
+}
+
+unsigned int IndexBuffer::ChooseType(const unsigned int* data, unsigned int count, bool allowBytes)
+{
+	// nothing to go by, the contents may need all 32 bits later
+	if (!data)
+		return GL_UNSIGNED_INT;
+
+	unsigned int maxIndex = 0;
+	for (unsigned int i = 0; i < count; i++)
+		maxIndex = data[i] > maxIndex ? data[i] : maxIndex;
+
+	if (allowBytes && maxIndex <= 0xFF)
+		return GL_UNSIGNED_BYTE;
+	if (maxIndex <= 0xFFFF)
+		return GL_UNSIGNED_SHORT;
+	return GL_UNSIGNED_INT;
+}
+
+const void* IndexBuffer::Convert(const unsigned int* data, unsigned int count, std::vector<unsigned char>& scratch) const
+{
+	if (!data || m_Type == GL_UNSIGNED_INT)
+		return data;
+
+	scratch.resize(count * GetTypeSize());
+	if (m_Type == GL_UNSIGNED_SHORT)
+	{
+		unsigned short* indices = (unsigned short*)scratch.data();
+		for (unsigned int i = 0; i < count; i++)
+		{
+			ASSERT(data[i] <= 0xFFFF);
+			indices[i] = (unsigned short)data[i];
+		}
+	}
+	else
+	{
+		for (unsigned int i = 0; i < count; i++)
+		{
+			ASSERT(data[i] <= 0xFF);
+			scratch[i] = (unsigned char)data[i];
+		}
+	}
+	return scratch.data();
+}
+
+// Updates go through GL_COPY_WRITE_BUFFER: binding GL_ELEMENT_ARRAY_BUFFER would
+// also attach the buffer to whichever vertex array happens to be bound
+
+void IndexBuffer::SetData(const unsigned int* data, unsigned int count)
+{
+	m_Type = ChooseType(data, count, m_AllowBytes);
+	m_Count = count;
+
+	std::vector<unsigned char> scratch;
+	const void* indices = Convert(data, count, scratch);
+
+	GLCall(glBindBuffer(GL_COPY_WRITE_BUFFER, m_RendererID));
+	GLCall(glBufferData(GL_COPY_WRITE_BUFFER, count * GetTypeSize(), indices, GetGLUsage(m_Usage)));
+}
+
+void IndexBuffer::Allocate(unsigned int count, unsigned int type)
+{
+	m_Type = type;
+	m_Count = count;
+
+	GLCall(glBindBuffer(GL_COPY_WRITE_BUFFER, m_RendererID));
+	GLCall(glBufferData(GL_COPY_WRITE_BUFFER, count * GetTypeSize(), nullptr, GetGLUsage(m_Usage)));
+}
+
+void IndexBuffer::SetSubData(const unsigned int* data, unsigned int count, unsigned int offset, BufferUpdate update)
+{
+	std::vector<unsigned char> scratch;
+	const void* indices = Convert(data, count, scratch);
+
+	GLCall(glBindBuffer(GL_COPY_WRITE_BUFFER, m_RendererID));
+	UpdateBuffer(GL_COPY_WRITE_BUFFER, indices, count * GetTypeSize(), offset * GetTypeSize(),
+		m_Count * GetTypeSize(), m_Usage, update);
+}
+
+void* IndexBuffer::Map(unsigned int count, unsigned int offset, BufferUpdate update)
+{
+	GLCall(glBindBuffer(GL_COPY_WRITE_BUFFER, m_RendererID));
+	return MapBuffer(GL_COPY_WRITE_BUFFER, count * GetTypeSize(), offset * GetTypeSize(),
+		m_Count * GetTypeSize(), update);
+}
+
+void IndexBuffer::Unmap()
+{
+	GLCall(glBindBuffer(GL_COPY_WRITE_BUFFER, m_RendererID));
+	GLCall(glUnmapBuffer(GL_COPY_WRITE_BUFFER));
 }
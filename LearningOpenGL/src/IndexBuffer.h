@@ -1,17 +1,54 @@
 #pragma once
 
+#include "BufferUsage.h"
 
+#include <vector>
+
+
+// Indices are handed in as unsigned int, but stored as 16 bit whenever the largest one fits,
+// which halves their memory and the bandwidth of fetching them. Draws pass GetType() to OpenGL.
 class IndexBuffer
 {
 private:
 	unsigned int m_RendererID;
 	unsigned int m_Count;
+	BufferUsage m_Usage;
+	// GL_UNSIGNED_BYTE, GL_UNSIGNED_SHORT or GL_UNSIGNED_INT
+	unsigned int m_Type;
+	bool m_AllowBytes;
 public:
-	IndexBuffer(const unsigned int* data, unsigned int count);
+	// The type is picked from the largest index in data, 32 bit when data is nullptr.
+	// 8 bit indices are only used with allowBytes, many GPUs convert them on the CPU
+	IndexBuffer(const unsigned int* data, unsigned int count, BufferUsage usage = BufferUsage::Static, bool allowBytes = false);
 	~IndexBuffer();
 
 	void Bind() const;
 	void Unbind() const;
 
+	// Replaces every index, count and type may differ from before
+	void SetData(const unsigned int* data, unsigned int count);
+	// Replaces the storage with room for count indices of type, left uninitialised to be written through Map
+	void Allocate(unsigned int count, unsigned int type);
+	// Overwrites count indices starting at index offset without reallocating.
+	// They have to fit the current type, use SetData when they may not
+	void SetSubData(const unsigned int* data, unsigned int count, unsigned int offset = 0,
+		BufferUpdate update = BufferUpdate::SubData);
+
+	// Returns where to write count indices of GetType() starting at index offset, until Unmap
+	void* Map(unsigned int count, unsigned int offset = 0, BufferUpdate update = BufferUpdate::SubData);
+	void Unmap();
+
 	inline unsigned int GetCount() const { return m_Count; }
+	inline unsigned int GetType() const { return m_Type; }
+	// bytes per index, e.g. to turn a first index into a byte offset
+	unsigned int GetTypeSize() const;
+	inline BufferUsage GetUsage() const { return m_Usage; }
+	inline unsigned int GetRendererID() const { return m_RendererID; }
+
+	// The smallest type that holds every index in data
+	static unsigned int ChooseType(const unsigned int* data, unsigned int count, bool allowBytes = false);
+
+private:
+	// Returns data in the buffer's type, converted into scratch unless it is already 32 bit
+	const void* Convert(const unsigned int* data, unsigned int count, std::vector<unsigned char>& scratch) const;
 };
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include <fstream>
 #include <string>
 #include <sstream>
+#include <memory>
 
 #include "glm/glm.hpp"
 #include "glm/gtc/matrix_transform.hpp"
@@ -16,12 +17,26 @@
 #include "VertexArray.h"
 #include "Shader.h"
 #include "Texture.h"
+#include "RenderThread.h"
+#include "GLDeletionQueue.h"
+#include "QuadIndexBuffer.h"
 
 #include "imgui/imgui.h"
 #include "imgui/imgui_impl_glfw_gl3.h"
 
 #include "tests/TestClearColor.h"
 #include "tests/TestTexture2D.h"
+#include "tests/TestBatchRendering.h"
+#include "tests/TestRenderQueue.h"
+#include "tests/TestInstancing.h"
+#include "tests/TestDrawIndirect.h"
+#include "tests/TestTransformHierarchy.h"
+#include "tests/TestSpriteStore.h"
+#include "tests/TestGPUCulling.h"
+#include "tests/TestTextureAtlas.h"
+#include "tests/TestBufferUpdate.h"
+#include "tests/TestMeshOptimizer.h"
+#include "tests/TestVertexStreams.h"
 
 /* Lecture: Creating a Texture Test in OpenGL */
 
@@ -98,18 +113,69 @@ int main(void)
 		//----------------------------------------------------------------------------------
 		//----------------------------------------------------------------------------------
 
+		// test for drawing many sprites through the batch renderer
+		testMenu->RegisterTest<test::TestBatchRendering>("Batch Rendering");
+
+		// test for sorting draws by state before submitting them
+		testMenu->RegisterTest<test::TestRenderQueue>("Render Queue");
+
+		// test for drawing one mesh many times with per-instance data
+		testMenu->RegisterTest<test::TestInstancing>("Instancing");
+
+		// test for drawing many meshes from one command buffer
+		testMenu->RegisterTest<test::TestDrawIndirect>("Draw Indirect");
+
+		// test for updating only the moving parts of a large transform hierarchy
+		testMenu->RegisterTest<test::TestTransformHierarchy>("Transform Hierarchy");
+
+		// test for drawing sprites kept in structure of arrays form
+		testMenu->RegisterTest<test::TestSpriteStore>("Sprite Store");
+
+		// test for culling and compacting draws with a compute shader
+		testMenu->RegisterTest<test::TestGPUCulling>("GPU Culling");
+
+		// test for packing many images into a few atlas textures
+		testMenu->RegisterTest<test::TestTextureAtlas>("Texture Atlas");
+
+		// test comparing ways of rewriting a vertex buffer every frame
+		testMenu->RegisterTest<test::TestBufferUpdate>("Buffer Update");
+
+		// test for reordering triangles and vertices of meshes before they are uploaded
+		testMenu->RegisterTest<test::TestMeshOptimizer>("Mesh Optimizer");
+
+		// test for updating one vertex stream of a vertex array while the others stay untouched
+		testMenu->RegisterTest<test::TestVertexStreams>("Vertex Streams");
+
+		// Render thread mode: the render thread owns the context and draws the last
+		// frame packet while the main thread updates the next one
+		std::unique_ptr<RenderThread> renderThread;
+		bool useRenderThread = false;
+
+		// seconds since the last frame, what the tests animate with
+		double lastTime = glfwGetTime();
+
 		/* Loop until the user closes the window */
 		while (!glfwWindowShouldClose(window))
 		{
+			double time = glfwGetTime();
+			float deltaTime = (float)(time - lastTime);
+			lastTime = time;
+
+			// packet of this frame, nullptr when drawing directly
+			FramePacket* packet = renderThread ? &renderThread->BeginFrame() : nullptr;
+
 			/* Render here */
 			//----------------------------------------------------------------------------------
 			// Previous
 			//----------------------------------------------------------------------------------
-			// set background color back to black
-			GLCall(glClearColor(0.0f, 0.0f, 0.0f, 1.0f));
+			if (!packet)
+			{
+				// set background color back to black
+				GLCall(glClearColor(0.0f, 0.0f, 0.0f, 1.0f));
 
-			// glClear(GL_COLOR_BUFFER_BIT); 
-			renderer.Clear();
+				// glClear(GL_COLOR_BUFFER_BIT); 
+				renderer.Clear();
+			}
 
 			// Sets up new ImGui frame (setup before any ImGui code for this frame)
 			ImGui_ImplGlfwGL3_NewFrame();
@@ -118,36 +184,67 @@ int main(void)
 			if (currentTest)
 			{
 				// setup the test
-				currentTest->OnUpdate(0.0f);
-				currentTest->OnRender();
+				if (packet)
+				{
+					currentTest->OnUpdate(deltaTime, *packet);
+				}
+				else
+				{
+					currentTest->OnUpdate(deltaTime);
+					currentTest->OnRender();
+				}
 				ImGui::Begin("Test");
 
 				// Still selecting the test in the test menu or returned to test menu
 				if (currentTest != testMenu && ImGui::Button("<-"))
 				{
+					// the packet may still point into the test
+					if (packet)
+						packet->Clear();
+
 					// delete the testing instance
-					delete currentTest;
+					RenderThread::Execute([&]() { delete currentTest; });
 					currentTest = testMenu;
 				}
 
 				// draw test UI
 				currentTest->OnImGuiRender();
+				ImGui::Checkbox("Render thread", &useRenderThread);
 				ImGui::End();
 			}
 
 			// Draw ImGui into frame buffer
 			ImGui::Render();
-			ImGui_ImplGlfwGL3_RenderDrawData(ImGui::GetDrawData());
+			if (packet)
+			{
+				// the render thread draws a copy, the next ImGui frame reuses the originals
+				packet->SetImGuiDrawData(ImGui::GetDrawData());
+				renderThread->EndFrame();
+			}
+			else
+			{
+				ImGui_ImplGlfwGL3_RenderDrawData(ImGui::GetDrawData());
+
+				/* Swap front and back buffers */
+				glfwSwapBuffers(window);
+				GLDeletionQueue::EndFrame();
+			}
 			//----------------------------------------------------------------------------------
 			//----------------------------------------------------------------------------------
 
-			/* Swap front and back buffers */
-			glfwSwapBuffers(window);
-
 			/* Poll for and process events */
 			glfwPollEvents();
+
+			// Switching modes moves the context between the threads
+			if (useRenderThread && !renderThread)
+				renderThread = std::make_unique<RenderThread>(window);
+			else if (!useRenderThread && renderThread)
+				renderThread.reset();
 		}
 
+		// the context has to be back on this thread before anything is deleted
+		renderThread.reset();
+
 		//----------------------------------------------------------------------------------
 		// Previous:
 		//----------------------------------------------------------------------------------
@@ -156,6 +253,9 @@ int main(void)
 			delete testMenu;
 	}
 	// glfwTerminate deletes OpenGl context so need scope to destroy shader before it.
+	// Destroyed objects are only queued for deletion, so free them while the context is alive.
+	QuadIndexBuffer::Shutdown();
+	GLDeletionQueue::Flush();
 
 	// Cleaning up ImGui
 	ImGui_ImplGlfwGL3_Shutdown();
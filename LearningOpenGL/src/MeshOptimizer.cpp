@@ -0,0 +1,257 @@
+#include "MeshOptimizer.h"
+#include "ParallelFor.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace {
+	// Scores of Forsyth's algorithm, both tables are filled once
+	const unsigned int MaxValence = 32;
+
+	struct ScoreTables
+	{
+		float Cache[MeshOptimizer::CacheSize];
+		float Valence[MaxValence];
+
+		ScoreTables()
+		{
+			// The three vertices of the triangle just added get a fixed score so the next triangle does
+			// not simply reuse the same edge, after them the score falls off with the position in the cache
+			for (unsigned int i = 0; i < MeshOptimizer::CacheSize; i++)
+			{
+				if (i < 3)
+					Cache[i] = 0.75f;
+				else
+					Cache[i] = std::pow(1.0f - (i - 3) / (float)(MeshOptimizer::CacheSize - 3), 1.5f);
+			}
+
+			// Vertices with few triangles left are boosted, so lone triangles are not left behind
+			for (unsigned int i = 0; i < MaxValence; i++)
+				Valence[i] = i ? 2.0f / std::sqrt((float)i) : 0.0f;
+		}
+	};
+
+	const ScoreTables& GetScoreTables()
+	{
+		static const ScoreTables tables;
+		return tables;
+	}
+
+	float VertexScore(const ScoreTables& tables, int cachePosition, unsigned int remaining)
+	{
+		// no triangles left to draw, the vertex no longer matters
+		if (remaining == 0)
+			return -1.0f;
+
+		float score = cachePosition >= 0 ? tables.Cache[cachePosition] : 0.0f;
+		score += remaining < MaxValence ? tables.Valence[remaining] : 2.0f / std::sqrt((float)remaining);
+		return score;
+	}
+}
+
+float MeshOptimizer::ComputeACMR(const unsigned int* indices, unsigned int indexCount, unsigned int vertexCount,
+	unsigned int cacheSize)
+{
+	if (indexCount < 3)
+		return 0.0f;
+
+	// A vertex is in the FIFO cache while fewer than cacheSize misses happened since it was added
+	std::vector<unsigned int> addedAt(vertexCount, 0);
+	unsigned int misses = 0;
+	for (unsigned int i = 0; i < indexCount; i++)
+	{
+		unsigned int vertex = indices[i];
+		if (addedAt[vertex] == 0 || misses - addedAt[vertex] >= cacheSize)
+		{
+			misses++;
+			addedAt[vertex] = misses;
+		}
+	}
+	return misses / (float)(indexCount / 3);
+}
+
+void MeshOptimizer::OptimizeVertexCache(unsigned int* indices, unsigned int indexCount, unsigned int vertexCount)
+{
+	const ScoreTables& tables = GetScoreTables();
+	unsigned int triangleCount = indexCount / 3;
+	if (triangleCount == 0)
+		return;
+
+	// Triangles of every vertex, a vertex's list shrinks as its triangles are drawn
+	std::vector<unsigned int> remaining(vertexCount, 0);
+	for (unsigned int i = 0; i < indexCount; i++)
+		remaining[indices[i]]++;
+
+	std::vector<unsigned int> firstTriangle(vertexCount + 1, 0);
+	for (unsigned int v = 0; v < vertexCount; v++)
+		firstTriangle[v + 1] = firstTriangle[v] + remaining[v];
+
+	std::vector<unsigned int> triangles(indexCount);
+	std::vector<unsigned int> filled(vertexCount, 0);
+	for (unsigned int t = 0; t < triangleCount; t++)
+	{
+		for (unsigned int k = 0; k < 3; k++)
+		{
+			unsigned int vertex = indices[t * 3 + k];
+			triangles[firstTriangle[vertex] + filled[vertex]++] = t;
+		}
+	}
+
+	std::vector<int> cachePosition(vertexCount, -1);
+	std::vector<float> vertexScore(vertexCount);
+	for (unsigned int v = 0; v < vertexCount; v++)
+		vertexScore[v] = VertexScore(tables, -1, remaining[v]);
+
+	std::vector<float> triangleScore(triangleCount);
+	std::vector<bool> drawn(triangleCount, false);
+	for (unsigned int t = 0; t < triangleCount; t++)
+		triangleScore[t] = vertexScore[indices[t * 3]] + vertexScore[indices[t * 3 + 1]] + vertexScore[indices[t * 3 + 2]];
+
+	// Starts with the best triangle of the whole mesh
+	int best = (int)(std::max_element(triangleScore.begin(), triangleScore.end()) - triangleScore.begin());
+
+	// Three more entries than the cache, for the vertices pushed out by the last triangle
+	unsigned int cache[CacheSize + 3];
+	unsigned int cacheCount = 0;
+	unsigned int nextUndrawn = 0;
+
+	std::vector<unsigned int> output(indexCount);
+	for (unsigned int out = 0; out < triangleCount; out++)
+	{
+		// Nothing in the cache has triangles left, continue with the next undrawn one in the original order
+		if (best < 0)
+		{
+			while (drawn[nextUndrawn])
+				nextUndrawn++;
+			best = (int)nextUndrawn;
+		}
+
+		const unsigned int* triangle = indices + best * 3;
+		memcpy(&output[out * 3], triangle, 3 * sizeof(unsigned int));
+		drawn[best] = true;
+
+		// The drawn triangle leaves the lists of its vertices
+		for (unsigned int k = 0; k < 3; k++)
+		{
+			unsigned int vertex = triangle[k];
+			unsigned int* list = &triangles[firstTriangle[vertex]];
+			unsigned int count = remaining[vertex];
+			for (unsigned int i = 0; i < count; i++)
+			{
+				if (list[i] == (unsigned int)best)
+				{
+					list[i] = list[count - 1];
+					break;
+				}
+			}
+			remaining[vertex]--;
+		}
+
+		// The triangle's vertices move to the front of the LRU cache
+		unsigned int newCache[CacheSize + 3];
+		unsigned int newCount = 0;
+		for (unsigned int k = 0; k < 3; k++)
+		{
+			// a degenerate triangle names a vertex twice
+			if (k == 0 || (triangle[k] != triangle[0] && (k == 1 || triangle[k] != triangle[1])))
+				newCache[newCount++] = triangle[k];
+		}
+		for (unsigned int i = 0; i < cacheCount; i++)
+		{
+			unsigned int vertex = cache[i];
+			if (vertex != triangle[0] && vertex != triangle[1] && vertex != triangle[2])
+				newCache[newCount++] = vertex;
+		}
+
+		// New scores for every vertex that is, or just stopped being, in the cache
+		for (unsigned int i = 0; i < newCount; i++)
+		{
+			unsigned int vertex = newCache[i];
+			cachePosition[vertex] = i < CacheSize ? (int)i : -1;
+			vertexScore[vertex] = VertexScore(tables, cachePosition[vertex], remaining[vertex]);
+		}
+
+		// and for their triangles, of which the best one is drawn next
+		best = -1;
+		float bestScore = -1.0f;
+		for (unsigned int i = 0; i < newCount; i++)
+		{
+			unsigned int vertex = newCache[i];
+			const unsigned int* list = &triangles[firstTriangle[vertex]];
+			for (unsigned int j = 0; j < remaining[vertex]; j++)
+			{
+				unsigned int t = list[j];
+				const unsigned int* corners = indices + t * 3;
+				float score = vertexScore[corners[0]] + vertexScore[corners[1]] + vertexScore[corners[2]];
+				triangleScore[t] = score;
+				if (score > bestScore)
+				{
+					bestScore = score;
+					best = (int)t;
+				}
+			}
+		}
+
+		cacheCount = std::min(newCount, CacheSize);
+		memcpy(cache, newCache, cacheCount * sizeof(unsigned int));
+	}
+
+	memcpy(indices, output.data(), indexCount * sizeof(unsigned int));
+}
+
+unsigned int MeshOptimizer::OptimizeVertexFetch(unsigned char* vertices, unsigned int vertexCount, unsigned int vertexSize,
+	unsigned int* indices, unsigned int indexCount)
+{
+	const unsigned int Unused = 0xFFFFFFFF;
+
+	// Vertices get new positions in the order the indices first reach them
+	std::vector<unsigned int> remap(vertexCount, Unused);
+	unsigned int next = 0;
+	for (unsigned int i = 0; i < indexCount; i++)
+	{
+		unsigned int& position = remap[indices[i]];
+		if (position == Unused)
+			position = next++;
+		indices[i] = position;
+	}
+
+	std::vector<unsigned char> reordered(next * vertexSize);
+	for (unsigned int v = 0; v < vertexCount; v++)
+	{
+		if (remap[v] != Unused)
+			memcpy(&reordered[remap[v] * vertexSize], vertices + v * vertexSize, vertexSize);
+	}
+	memcpy(vertices, reordered.data(), reordered.size());
+	return next;
+}
+
+MeshOptimizeStats MeshOptimizer::Optimize(MeshSource& mesh)
+{
+	MeshOptimizeStats stats;
+	unsigned int vertexCount = mesh.GetVertexCount();
+	unsigned int indexCount = (unsigned int)mesh.Indices.size();
+
+	stats.ACMRBefore = ComputeACMR(mesh.Indices.data(), indexCount, vertexCount);
+	OptimizeVertexCache(mesh.Indices.data(), indexCount, vertexCount);
+	vertexCount = OptimizeVertexFetch(mesh.Vertices.data(), vertexCount, mesh.VertexSize, mesh.Indices.data(), indexCount);
+	mesh.Vertices.resize(vertexCount * mesh.VertexSize);
+
+	// Renaming vertices changes nothing for the cache, so this is the order the triangles were given
+	stats.ACMRAfter = ComputeACMR(mesh.Indices.data(), indexCount, vertexCount);
+	return stats;
+}
+
+std::vector<MeshOptimizeStats> MeshOptimizer::Optimize(std::vector<MeshSource>& meshes, unsigned int threadCount)
+{
+	if (threadCount == 0)
+		threadCount = std::max(1u, std::thread::hardware_concurrency());
+
+	// Meshes are independent, each thread takes whole meshes
+	std::vector<MeshOptimizeStats> stats(meshes.size());
+	ParallelFor((unsigned int)meshes.size(), threadCount, [&](unsigned int i)
+	{
+		stats[i] = Optimize(meshes[i]);
+	});
+	return stats;
+}
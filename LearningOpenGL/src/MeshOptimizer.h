@@ -0,0 +1,52 @@
+#pragma once
+
+#include <vector>
+
+// A mesh on the CPU before its buffers are created: vertices of any layout, VertexSize bytes
+// each, and triangle list indices into them
+struct MeshSource
+{
+	std::vector<unsigned char> Vertices;
+	unsigned int VertexSize = 0;
+	std::vector<unsigned int> Indices;
+
+	inline unsigned int GetVertexCount() const { return VertexSize ? (unsigned int)(Vertices.size() / VertexSize) : 0; }
+};
+
+// Average cache miss ratio of a mesh before and after optimising it
+struct MeshOptimizeStats
+{
+	float ACMRBefore = 0.0f;
+	float ACMRAfter = 0.0f;
+};
+
+// Load-time reordering of meshes so the GPU does less work for the same triangles, meant to run
+// on a MeshSource before its VertexBuffer and IndexBuffer are created:
+// - triangles are reordered (Tom Forsyth's linear-speed vertex cache optimisation) so vertices
+//   shaded for one triangle are still in the post-transform cache for the next ones
+// - vertices are then reordered into the order the triangles first use them, so fetching
+//   them walks through memory instead of jumping around it
+class MeshOptimizer
+{
+public:
+	// Size of the LRU cache the triangle order is optimised for, larger than most real caches on purpose
+	static const unsigned int CacheSize = 32;
+
+	// Average cache miss ratio: vertices shaded per triangle with a FIFO cache of cacheSize vertices.
+	// 3 shades every vertex of every triangle, the best a regular grid can get close to is 0.5
+	static float ComputeACMR(const unsigned int* indices, unsigned int indexCount, unsigned int vertexCount,
+		unsigned int cacheSize = 16);
+
+	// Reorders the triangles of indices in place for the post-transform vertex cache
+	static void OptimizeVertexCache(unsigned int* indices, unsigned int indexCount, unsigned int vertexCount);
+
+	// Reorders the vertices into first use order and rewrites indices to match.
+	// Vertices no triangle uses are dropped, returns how many are left
+	static unsigned int OptimizeVertexFetch(unsigned char* vertices, unsigned int vertexCount, unsigned int vertexSize,
+		unsigned int* indices, unsigned int indexCount);
+
+	// Both steps on one mesh
+	static MeshOptimizeStats Optimize(MeshSource& mesh);
+	// Every mesh, spread over threadCount threads (0 uses one per core). Returns the stats of each mesh
+	static std::vector<MeshOptimizeStats> Optimize(std::vector<MeshSource>& meshes, unsigned int threadCount = 0);
+};
\ No newline at end of file
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <thread>
+#include <vector>
+
+// Runs work(0) .. work(count - 1) spread over threadCount threads, the calling thread being one of them.
+// Items are handed out one at a time, so uneven items still keep every thread busy
+inline void ParallelFor(unsigned int count, unsigned int threadCount, const std::function<void(unsigned int)>& work)
+{
+	std::atomic<unsigned int> next(0);
+	auto worker = [&]()
+	{
+		for (unsigned int i = next++; i < count; i = next++)
+			work(i);
+	};
+
+	std::vector<std::thread> threads;
+	for (unsigned int t = 1; t < threadCount && t < count; t++)
+		threads.emplace_back(worker);
+	worker();
+
+	for (std::thread& thread : threads)
+		thread.join();
+}
\ No newline at end of file
@@ -0,0 +1,105 @@
+#include "QuadIndexBuffer.h"
+
+#include "Renderer.h"
+
+#include <emmintrin.h>
+
+std::unique_ptr<IndexBuffer> QuadIndexBuffer::s_Buffer;
+unsigned int QuadIndexBuffer::s_QuadCount = 0;
+
+const IndexBuffer& QuadIndexBuffer::Get(unsigned int quadCount)
+{
+	if (!s_Buffer)
+		s_Buffer = std::make_unique<IndexBuffer>(nullptr, 0);
+
+	if (quadCount > s_QuadCount)
+	{
+		// Doubling keeps the number of regrows logarithmic in the largest batch
+		unsigned int capacity = s_QuadCount ? s_QuadCount : MinQuads;
+		while (capacity < quadCount)
+			capacity *= 2;
+
+		unsigned int type = capacity * 4 - 1 <= 0xFFFF ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+		s_Buffer->Allocate(capacity * 6, type);
+
+		// Written straight into the new storage, no copy on the CPU
+		void* indices = s_Buffer->Map(capacity * 6);
+		if (type == GL_UNSIGNED_SHORT)
+			Fill((unsigned short*)indices, capacity);
+		else
+			Fill((unsigned int*)indices, capacity);
+		s_Buffer->Unmap();
+
+		s_QuadCount = capacity;
+	}
+	return *s_Buffer;
+}
+
+void QuadIndexBuffer::Shutdown()
+{
+	s_Buffer.reset();
+	s_QuadCount = 0;
+}
+
+void QuadIndexBuffer::Fill(unsigned short* indices, unsigned int quadCount)
+{
+	// Four quads make 24 indices, exactly three registers of eight, and the next four
+	// quads are the same registers plus 16
+	__m128i a = _mm_setr_epi16(0, 1, 2, 2, 3, 0, 4, 5);
+	__m128i b = _mm_setr_epi16(6, 6, 7, 4, 8, 9, 10, 10);
+	__m128i c = _mm_setr_epi16(11, 8, 12, 13, 14, 14, 15, 12);
+	const __m128i step = _mm_set1_epi16(16);
+
+	unsigned int quad = 0;
+	for (; quad + 4 <= quadCount; quad += 4, indices += 24)
+	{
+		_mm_storeu_si128((__m128i*)(indices + 0), a);
+		_mm_storeu_si128((__m128i*)(indices + 8), b);
+		_mm_storeu_si128((__m128i*)(indices + 16), c);
+		a = _mm_add_epi16(a, step);
+		b = _mm_add_epi16(b, step);
+		c = _mm_add_epi16(c, step);
+	}
+
+	for (; quad < quadCount; quad++, indices += 6)
+	{
+		unsigned short offset = (unsigned short)(quad * 4);
+		indices[0] = offset + 0;
+		indices[1] = offset + 1;
+		indices[2] = offset + 2;
+		indices[3] = offset + 2;
+		indices[4] = offset + 3;
+		indices[5] = offset + 0;
+	}
+}
+
+void QuadIndexBuffer::Fill(unsigned int* indices, unsigned int quadCount)
+{
+	// Two quads make 12 indices, three registers of four
+	__m128i a = _mm_setr_epi32(0, 1, 2, 2);
+	__m128i b = _mm_setr_epi32(3, 0, 4, 5);
+	__m128i c = _mm_setr_epi32(6, 6, 7, 4);
+	const __m128i step = _mm_set1_epi32(8);
+
+	unsigned int quad = 0;
+	for (; quad + 2 <= quadCount; quad += 2, indices += 12)
+	{
+		_mm_storeu_si128((__m128i*)(indices + 0), a);
+		_mm_storeu_si128((__m128i*)(indices + 4), b);
+		_mm_storeu_si128((__m128i*)(indices + 8), c);
+		a = _mm_add_epi32(a, step);
+		b = _mm_add_epi32(b, step);
+		c = _mm_add_epi32(c, step);
+	}
+
+	for (; quad < quadCount; quad++, indices += 6)
+	{
+		unsigned int offset = quad * 4;
+		indices[0] = offset + 0;
+		indices[1] = offset + 1;
+		indices[2] = offset + 2;
+		indices[3] = offset + 2;
+		indices[4] = offset + 3;
+		indices[5] = offset + 0;
+	}
+}
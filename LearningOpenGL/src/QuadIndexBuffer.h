@@ -0,0 +1,32 @@
+#pragma once
+
+#include "IndexBuffer.h"
+
+#include <memory>
+
+// One index buffer for every batch of quads in the process. Quad i is drawn with the
+// two triangles { 4i, 4i+1, 4i+2 } and { 4i+2, 4i+3, 4i }, so the indices only depend
+// on how many quads there are and are never uploaded per frame.
+// The buffer grows by doubling whenever a batch needs more quads than it holds, and
+// stays 16 bit for up to 16384 quads.
+class QuadIndexBuffer
+{
+private:
+	// quads the buffer starts with
+	static const unsigned int MinQuads = 1024;
+
+	static std::unique_ptr<IndexBuffer> s_Buffer;
+	static unsigned int s_QuadCount;
+
+public:
+	// Context thread: the shared buffer, holding indices for at least quadCount quads.
+	// It is always the same object, growing only changes its storage
+	static const IndexBuffer& Get(unsigned int quadCount);
+
+	// Context thread: deletes the buffer, e.g. before the context goes away
+	static void Shutdown();
+
+	// Writes the 6 indices of each of quadCount quads
+	static void Fill(unsigned short* indices, unsigned int quadCount);
+	static void Fill(unsigned int* indices, unsigned int quadCount);
+};
\ No newline at end of file
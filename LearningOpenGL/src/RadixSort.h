@@ -0,0 +1,68 @@
+#pragma once
+
+#include <vector>
+#include <cstring>
+#include <utility>
+
+// LSD radix sort of (key, value) pairs, 8 bits of the key per pass.
+// Every pass keeps the order of equal keys, so the sort is stable.
+// keys/values hold the result, the scratch vectors are resized and reused between calls.
+template<typename Key>
+void RadixSort(std::vector<Key>& keys, std::vector<unsigned int>& values,
+	std::vector<Key>& keyScratch, std::vector<unsigned int>& valueScratch)
+{
+	const unsigned int passes = sizeof(Key);
+	const size_t count = keys.size();
+	keyScratch.resize(count);
+	valueScratch.resize(count);
+
+	// Histograms for every byte are built in a single read of the keys
+	unsigned int histograms[sizeof(Key)][256];
+	std::memset(histograms, 0, sizeof(histograms));
+	for (size_t i = 0; i < count; i++)
+	{
+		Key key = keys[i];
+		for (unsigned int pass = 0; pass < passes; pass++)
+			histograms[pass][(key >> (pass * 8)) & 0xFF]++;
+	}
+
+	Key* srcKeys = keys.data();
+	unsigned int* srcValues = values.data();
+	Key* dstKeys = keyScratch.data();
+	unsigned int* dstValues = valueScratch.data();
+
+	for (unsigned int pass = 0; pass < passes; pass++)
+	{
+		unsigned int* histogram = histograms[pass];
+
+		// A byte that is the same in every key would not move anything
+		if (count == 0 || histogram[(srcKeys[0] >> (pass * 8)) & 0xFF] == count)
+			continue;
+
+		// Turn the counts into the first output slot of each bucket
+		unsigned int offset = 0;
+		for (unsigned int bucket = 0; bucket < 256; bucket++)
+		{
+			unsigned int bucketCount = histogram[bucket];
+			histogram[bucket] = offset;
+			offset += bucketCount;
+		}
+
+		for (size_t i = 0; i < count; i++)
+		{
+			unsigned int slot = histogram[(srcKeys[i] >> (pass * 8)) & 0xFF]++;
+			dstKeys[slot] = srcKeys[i];
+			dstValues[slot] = srcValues[i];
+		}
+
+		std::swap(srcKeys, dstKeys);
+		std::swap(srcValues, dstValues);
+	}
+
+	// After an odd number of passes the result is sitting in the scratch buffers
+	if (srcKeys != keys.data())
+	{
+		keys.swap(keyScratch);
+		values.swap(valueScratch);
+	}
+}
\ No newline at end of file
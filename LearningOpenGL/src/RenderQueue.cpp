@@ -0,0 +1,119 @@
+#include "RenderQueue.h"
+
+#include "Renderer.h"
+#include "Texture.h"
+#include "RadixSort.h"
+
+#include <chrono>
+
+RenderQueue::RenderQueue(SortOrder order)
+	: m_SortOrder(order)
+{
+}
+
+uint64_t RenderQueue::MakeSortKey(unsigned int layer, unsigned int shader, unsigned int texture, unsigned int vao, float depth)
+{
+	// The coarse bucket draws near objects first so early-z can reject what they hide, without
+	// splitting state groups too much. The fine bits only order objects that share all their state
+	depth = glm::clamp(depth, 0.0f, 1.0f);
+	uint64_t depthBits = (uint64_t)(depth * 255.0f);
+
+	return ((uint64_t)(layer & 0xFF) << 56) |
+		((depthBits >> 4) << 52) |
+		((uint64_t)(shader & 0xFFFF) << 36) |
+		((uint64_t)(texture & 0xFFFF) << 20) |
+		((uint64_t)(vao & 0xFFFF) << 4) |
+		(depthBits & 0xF);
+}
+
+uint32_t RenderQueue::MakeDepthSortKey(unsigned int layer, float depth)
+{
+	// Inverted so that ascending keys draw the farthest object first
+	depth = glm::clamp(depth, 0.0f, 1.0f);
+	uint32_t depthBits = (uint32_t)((1.0f - depth) * 16777215.0f);
+
+	return ((uint32_t)(layer & 0xFF) << 24) | depthBits;
+}
+
+void RenderQueue::Submit(const RenderCommand& command, unsigned int layer, float depth)
+{
+	if (m_SortOrder == SortOrder::BackToFront)
+	{
+		m_DepthKeys.push_back(MakeDepthSortKey(layer, depth));
+	}
+	else
+	{
+		unsigned int texture = command.Tex ? command.Tex->GetRendererID() : 0;
+		m_Keys.push_back(MakeSortKey(layer, command.Program->GetRendererID(), texture, command.VAO->GetRendererID(), depth));
+	}
+	m_Order.push_back((unsigned int)m_Commands.size());
+	m_Commands.push_back(command);
+}
+
+void RenderQueue::Execute()
+{
+	m_Stats = QueueStats();
+	m_Stats.Commands = (unsigned int)m_Commands.size();
+
+	// Both sorts are stable, equal keys keep their submission order
+	auto start = std::chrono::high_resolution_clock::now();
+	if (m_SortOrder == SortOrder::BackToFront)
+		RadixSort(m_DepthKeys, m_Order, m_DepthKeyScratch, m_OrderScratch);
+	else
+		RadixSort(m_Keys, m_Order, m_KeyScratch, m_OrderScratch);
+	auto end = std::chrono::high_resolution_clock::now();
+	m_Stats.SortTime = std::chrono::duration<float, std::milli>(end - start).count();
+
+	// what is currently bound, so that only changes reach OpenGL
+	const Shader* boundShader = nullptr;
+	const Texture* boundTexture = nullptr;
+	const VertexArray* boundVAO = nullptr;
+	const IndexBuffer* boundIBO = nullptr;
+
+	for (unsigned int index : m_Order)
+	{
+		const RenderCommand& command = m_Commands[index];
+
+		if (command.Program != boundShader)
+		{
+			command.Program->Bind();
+			boundShader = command.Program;
+			m_Stats.ShaderBinds++;
+		}
+
+		if (command.Tex && command.Tex != boundTexture)
+		{
+			command.Tex->Bind();
+			boundTexture = command.Tex;
+			m_Stats.TextureBinds++;
+		}
+
+		if (command.VAO != boundVAO)
+		{
+			command.VAO->Bind();
+			boundVAO = command.VAO;
+			m_Stats.VertexArrayBinds++;
+
+			// the element buffer binding belongs to the vertex array
+			boundIBO = nullptr;
+		}
+
+		if (command.IBO != boundIBO)
+		{
+			command.IBO->Bind();
+			boundIBO = command.IBO;
+		}
+
+		// The per object matrix is the only thing left to upload
+		command.Program->SetUniformMat4f("u_MVP", command.MVP);
+		GLCall(glDrawElements(GL_TRIANGLES, command.IBO->GetCount(), command.IBO->GetType(), nullptr));
+	}
+}
+
+void RenderQueue::Clear()
+{
+	m_Commands.clear();
+	m_Keys.clear();
+	m_DepthKeys.clear();
+	m_Order.clear();
+}
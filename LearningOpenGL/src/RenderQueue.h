@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "glm/glm.hpp"
+
+class VertexArray;
+class IndexBuffer;
+class Shader;
+class Texture;
+
+// Everything needed to draw one object later, in any order
+struct RenderCommand
+{
+	const VertexArray* VAO;
+	const IndexBuffer* IBO;
+	Shader* Program;
+	// may be nullptr for untextured objects
+	const Texture* Tex;
+	glm::mat4 MVP;
+};
+
+// How much GL state the last Execute had to change
+struct QueueStats
+{
+	unsigned int Commands = 0;
+	unsigned int ShaderBinds = 0;
+	unsigned int TextureBinds = 0;
+	unsigned int VertexArrayBinds = 0;
+	// time spent sorting the keys, in milliseconds
+	float SortTime = 0.0f;
+
+	inline unsigned int GetStateChanges() const { return ShaderBinds + TextureBinds + VertexArrayBinds; }
+};
+
+class RenderQueue
+{
+public:
+	enum class SortOrder
+	{
+		// Opaque objects: nearer objects first so early-z rejects hidden pixels, grouped by state within a depth range
+		FrontToBack,
+		// Blended objects: by layer, then farthest first. Never reordered for state
+		BackToFront
+	};
+
+private:
+	SortOrder m_SortOrder;
+	std::vector<RenderCommand> m_Commands;
+
+	// sort keys and the command index they belong to (plus scratch space for the radix sort)
+	std::vector<uint64_t> m_Keys, m_KeyScratch;
+	std::vector<uint32_t> m_DepthKeys, m_DepthKeyScratch;
+	std::vector<unsigned int> m_Order, m_OrderScratch;
+
+	QueueStats m_Stats;
+
+public:
+	RenderQueue(SortOrder order = SortOrder::FrontToBack);
+
+	// Depth is expected in [0, 1], 0 being nearest to the camera.
+	// Key layout, most significant first: layer (8) | depth bucket (4) | shader (16) | texture (16) | vertex array (16) | depth (4)
+	static uint64_t MakeSortKey(unsigned int layer, unsigned int shader, unsigned int texture, unsigned int vao, float depth);
+	// Key layout, most significant first: layer (8) | inverted depth (24)
+	static uint32_t MakeDepthSortKey(unsigned int layer, float depth);
+
+	void Submit(const RenderCommand& command, unsigned int layer = 0, float depth = 0.0f);
+
+	// Sorts the commands by key and draws them, binding shader, texture and vertex array only when they change.
+	// Commands with equal keys are drawn in the order they were submitted
+	void Execute();
+	void Clear();
+
+	inline unsigned int GetCommandCount() const { return (unsigned int)m_Commands.size(); }
+	inline SortOrder GetSortOrder() const { return m_SortOrder; }
+	inline const QueueStats& GetStats() const { return m_Stats; }
+};
\ No newline at end of file
@@ -0,0 +1,159 @@
+#include "RenderThread.h"
+#include "GLDeletionQueue.h"
+
+#include <GLFW/glfw3.h>
+
+RenderThread* RenderThread::s_Instance = nullptr;
+
+RenderThread::RenderThread(GLFWwindow* window)
+	: m_Window(window), m_WriteIndex(0), m_PendingIndex(-1), m_ExecutingIndex(-1), m_Running(true)
+{
+	// A context can only be current on one thread at a time
+	glfwMakeContextCurrent(nullptr);
+
+	s_Instance = this;
+	m_Thread = std::thread(&RenderThread::Run, this);
+}
+
+RenderThread::~RenderThread()
+{
+	{
+		std::unique_lock<std::mutex> lock(m_Mutex);
+		m_Condition.wait(lock, [this]() { return m_PendingIndex == -1 && m_ExecutingIndex == -1 && m_Jobs.empty(); });
+		m_Running = false;
+	}
+	m_Condition.notify_all();
+	m_Thread.join();
+
+	s_Instance = nullptr;
+	glfwMakeContextCurrent(m_Window);
+}
+
+FramePacket& RenderThread::BeginFrame()
+{
+	std::unique_lock<std::mutex> lock(m_Mutex);
+	int writeIndex = (int)m_WriteIndex;
+	m_Condition.wait(lock, [this, writeIndex]() { return m_PendingIndex != writeIndex && m_ExecutingIndex != writeIndex; });
+
+	FramePacket& packet = m_Packets[m_WriteIndex];
+	packet.Clear();
+	return packet;
+}
+
+void RenderThread::EndFrame()
+{
+	bool synchronous = m_Packets[m_WriteIndex].IsSynchronous();
+	{
+		// The render thread may not have started the previous packet yet, replacing it would drop a frame
+		std::unique_lock<std::mutex> lock(m_Mutex);
+		m_Condition.wait(lock, [this]() { return m_PendingIndex == -1; });
+		m_PendingIndex = (int)m_WriteIndex;
+		m_WriteIndex ^= 1;
+	}
+	m_Condition.notify_all();
+
+	// the packet calls back into objects the main thread is about to update
+	if (synchronous)
+	{
+		std::unique_lock<std::mutex> lock(m_Mutex);
+		m_Condition.wait(lock, [this]() { return m_PendingIndex == -1 && m_ExecutingIndex == -1; });
+	}
+}
+
+void RenderThread::Execute(const std::function<void()>& job)
+{
+	RenderThread* renderThread = s_Instance;
+	if (!renderThread || std::this_thread::get_id() == renderThread->m_Thread.get_id())
+	{
+		job();
+		return;
+	}
+
+	Job pending = { job, false };
+	std::unique_lock<std::mutex> lock(renderThread->m_Mutex);
+	renderThread->m_Jobs.push_back(&pending);
+	renderThread->m_Condition.notify_all();
+	renderThread->m_Condition.wait(lock, [&pending]() { return pending.Done; });
+}
+
+void RenderThread::Run()
+{
+	glfwMakeContextCurrent(m_Window);
+
+	std::unique_lock<std::mutex> lock(m_Mutex);
+	while (true)
+	{
+		m_Condition.wait(lock, [this]() { return m_PendingIndex != -1 || !m_Jobs.empty() || !m_Running; });
+
+		// packets before jobs, a job may delete what a handed over packet still draws
+		if (m_PendingIndex != -1)
+		{
+			m_ExecutingIndex = m_PendingIndex;
+			m_PendingIndex = -1;
+			lock.unlock();
+			m_Condition.notify_all();
+
+			ExecutePacket(m_Packets[m_ExecutingIndex]);
+
+			lock.lock();
+			m_ExecutingIndex = -1;
+			m_Condition.notify_all();
+		}
+		else if (!m_Jobs.empty())
+		{
+			Job* job = m_Jobs.front();
+			m_Jobs.erase(m_Jobs.begin());
+			lock.unlock();
+
+			job->Work();
+
+			lock.lock();
+			job->Done = true;
+			m_Condition.notify_all();
+		}
+		else if (!m_Running)
+		{
+			break;
+		}
+	}
+	lock.unlock();
+
+	glfwMakeContextCurrent(nullptr);
+}
+
+void RenderThread::ExecutePacket(const FramePacket& packet)
+{
+	const glm::vec4& clearColor = packet.GetClearColor();
+	GLCall(glClearColor(clearColor.r, clearColor.g, clearColor.b, clearColor.a));
+	m_Renderer.Clear();
+	if (packet.IsDepthTest())
+	{
+		GLCall(glClear(GL_DEPTH_BUFFER_BIT));
+		GLCall(glEnable(GL_DEPTH_TEST));
+	}
+
+	// Draws are sorted by state like any other queued draw
+	for (const FramePacket::Command& command : packet.GetCommands())
+	{
+		const RenderCommand& draw = command.Draw;
+		if (command.Transparent)
+			m_Renderer.SubmitTransparent(*draw.VAO, *draw.IBO, *draw.Program, draw.Tex, draw.MVP, command.Layer, command.Depth);
+		else
+			m_Renderer.Submit(*draw.VAO, *draw.IBO, *draw.Program, draw.Tex, draw.MVP, command.Layer, command.Depth);
+	}
+	m_Renderer.FlushQueue();
+
+	// callbacks and ImGui expect the default state
+	if (packet.IsDepthTest())
+	{
+		GLCall(glDisable(GL_DEPTH_TEST));
+	}
+
+	for (const std::function<void()>& callback : packet.GetCallbacks())
+		callback();
+
+	packet.RenderImGui();
+
+	glfwSwapBuffers(m_Window);
+	GLDeletionQueue::EndFrame();
+}
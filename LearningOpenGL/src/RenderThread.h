@@ -0,0 +1,67 @@
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "FramePacket.h"
+#include "Renderer.h"
+
+struct GLFWwindow;
+
+// Owns the OpenGL context on a thread of its own. The main thread fills one frame
+// packet while the render thread draws the previous one, so at most one frame is
+// in flight and simulation overlaps with GL submission.
+class RenderThread
+{
+private:
+	GLFWwindow* m_Window;
+	std::thread m_Thread;
+
+	std::mutex m_Mutex;
+	std::condition_variable m_Condition;
+
+	// double buffered packets, the main thread writes m_Packets[m_WriteIndex]
+	FramePacket m_Packets[2];
+	unsigned int m_WriteIndex;
+	// packet handed over but not yet started, -1 when none
+	int m_PendingIndex;
+	// packet being drawn right now, -1 when idle
+	int m_ExecutingIndex;
+
+	// work that must run with the context, e.g. creating and deleting GL objects
+	struct Job
+	{
+		std::function<void()> Work;
+		bool Done;
+	};
+	std::vector<Job*> m_Jobs;
+
+	bool m_Running;
+
+	Renderer m_Renderer;
+
+	static RenderThread* s_Instance;
+
+public:
+	// Takes the context of window away from the calling thread
+	RenderThread(GLFWwindow* window);
+	// Finishes all packets and gives the context back to the calling thread
+	~RenderThread();
+
+	// The packet for the next frame, waits while the render thread is still drawing it
+	FramePacket& BeginFrame();
+	// Hands the packet to the render thread, once it has started the previous one
+	void EndFrame();
+
+	// Runs job with the GL context and waits for it. Without a render thread, or when
+	// called from it, the job runs straight away. Jobs run after every packet handed
+	// over before them, so deleting objects those packets use is safe.
+	static void Execute(const std::function<void()>& job);
+
+private:
+	void Run();
+	void ExecutePacket(const FramePacket& packet);
+};
\ No newline at end of file
@@ -1,6 +1,19 @@
 #include "Renderer.h"
+#include "VertexBufferLayout.h"
+#include "StaticLayout.h"
+#include "Texture.h"
+#include "Camera.h"
+#include "UniformBuffer.h"
+#include "SpriteStore.h"
+#include "RadixSort.h"
+#include "GPUCuller.h"
+#include "QuadIndexBuffer.h"
+
+#include <GLFW/glfw3.h>
 
 #include <iostream>
+#include <cmath>
+#include <cstring>
 
 // Clears all remaining error flags in OpenGL
 void GLClearError()
@@ -8,6 +21,12 @@ void GLClearError()
 	while (glGetError() != GL_NO_ERROR);
 }
 
+bool GLIsContextThread()
+{
+	// GLFW keeps the current context per thread
+	return glfwGetCurrentContext() != nullptr;
+}
+
 // A function that indicates when and where an OpenGl error occurs
 bool GLLogCall(const char* function, const char* file, int line)
 {
@@ -33,5 +52,317 @@ void Renderer::Draw(const VertexArray & va, const IndexBuffer & ib, const Shader
 	ib.Bind();
 
 	// Drawing primitives using the index buffer
-	GLCall(glDrawElements(GL_TRIANGLES, ib.GetCount(), GL_UNSIGNED_INT, nullptr));
+	GLCall(glDrawElements(GL_TRIANGLES, ib.GetCount(), ib.GetType(), nullptr));
+}
+
+void Renderer::DrawInstanced(const VertexArray& va, const IndexBuffer& ib, const Shader& shader, unsigned int instanceCount) const
+{
+	shader.Bind();
+	va.Bind();
+	ib.Bind();
+
+	// One draw call for every instance of the mesh
+	GLCall(glDrawElementsInstanced(GL_TRIANGLES, ib.GetCount(), ib.GetType(), nullptr, instanceCount));
+}
+
+void Renderer::DrawCulled(const VertexArray& va, const IndexBuffer& ib, const Shader& shader, const GPUCuller& culler) const
+{
+	shader.Bind();
+	va.Bind();
+	ib.Bind();
+	culler.BindForDraw();
+
+	// The instance count was written by the compute shader
+	GLCall(glDrawElementsIndirect(GL_TRIANGLES, ib.GetType(), nullptr));
+}
+
+void Renderer::DrawIndirect(const VertexArray& va, const IndexBuffer& ib, const Shader& shader, const DrawIndirectBuffer& draws) const
+{
+	if (draws.GetDrawCount() == 0)
+		return;
+
+	shader.Bind();
+	va.Bind();
+	ib.Bind();
+
+	if (DrawIndirectBuffer::IsMultiDrawSupported())
+	{
+		// The GPU reads every command itself, no per draw work on the CPU
+		draws.Bind();
+		GLCall(glMultiDrawElementsIndirect(GL_TRIANGLES, ib.GetType(), nullptr, draws.GetDrawCount(), 0));
+		return;
+	}
+
+	// GL 3.3 has no base instance, so the draw ID attribute is switched to a constant
+	// value that is set before each draw instead
+	int drawIDAttrib = draws.GetDrawIDAttrib();
+	if (drawIDAttrib >= 0)
+	{
+		GLCall(glDisableVertexAttribArray(drawIDAttrib));
+	}
+
+	for (const DrawElementsIndirectCommand& command : draws.GetCommands())
+	{
+		if (drawIDAttrib >= 0)
+		{
+			GLCall(glVertexAttrib1f(drawIDAttrib, (float)command.BaseInstance));
+		}
+
+		void* indices = (void*)(uintptr_t)(command.FirstIndex * ib.GetTypeSize());
+		if (command.InstanceCount == 1)
+		{
+			GLCall(glDrawElementsBaseVertex(GL_TRIANGLES, command.Count, ib.GetType(), indices, command.BaseVertex));
+		}
+		else
+		{
+			GLCall(glDrawElementsInstancedBaseVertex(GL_TRIANGLES, command.Count, ib.GetType(), indices,
+				command.InstanceCount, command.BaseVertex));
+		}
+	}
+
+	if (drawIDAttrib >= 0)
+	{
+		GLCall(glEnableVertexAttribArray(drawIDAttrib));
+	}
+}
+
+// Creates the buffers shared by every batch (only once per renderer)
+void Renderer::InitBatch()
+{
+	m_BatchVertices.reserve(MaxBatchQuads * 4);
+
+	// Room for three full batches, so a flush rarely waits on a range the GPU is still drawing from
+	m_BatchVertexBuffer = std::make_unique<StreamingBuffer>(3 * MaxBatchQuads * 4 * (unsigned int)sizeof(BatchVertex));
+
+	// position, texture coordinates, color and texture slot of each BatchVertex
+	using BatchLayout = StaticLayout<Float3, Float2, Float4, Float1>;
+	static_assert(BatchLayout::Stride == sizeof(BatchVertex), "BatchLayout does not match BatchVertex");
+
+	m_BatchVAO = std::make_unique<VertexArray>();
+	m_BatchVAO->AddBuffer(*m_BatchVertexBuffer, BatchLayout());
+
+	// Indices come from the shared quad buffer, grown here once so the first flush does not have to
+	QuadIndexBuffer::Get(MaxBatchQuads);
+}
+
+void Renderer::SetCamera(const Camera& camera, UniformBuffer& cameraBuffer) const
+{
+	CameraUniforms uniforms = camera.GetUniforms();
+	cameraBuffer.Bind();
+	cameraBuffer.SetData(&uniforms, sizeof(CameraUniforms));
+}
+
+void Renderer::BeginBatch(Shader& shader, const Camera& camera)
+{
+	BeginBatch(shader, camera.GetViewProjection());
+}
+
+void Renderer::BeginBatch(Shader& shader, const glm::mat4& viewProj)
+{
+	if (!m_BatchVAO)
+		InitBatch();
+
+	// The quads are already in world space, only the camera is left for the shader
+	m_BatchShader = &shader;
+	m_BatchShader->Bind();
+	m_BatchShader->SetUniformMat4f("u_ViewProj", viewProj);
+
+	// Slot i of the sampler array reads texture unit i
+	int slots[MaxBatchTextures];
+	for (unsigned int i = 0; i < MaxBatchTextures; i++)
+		slots[i] = (int)i;
+	m_BatchShader->SetUniform1iv("u_Textures", GetMaxBatchTextures(), slots);
+
+	m_BatchVertices.clear();
+	m_BatchTextures.clear();
+}
+
+unsigned int Renderer::s_MaxBatchTextures = 0;
+
+unsigned int Renderer::GetMaxBatchTextures()
+{
+	if (s_MaxBatchTextures == 0)
+	{
+		int units;
+		GLCall(glGetIntegerv(GL_MAX_TEXTURE_IMAGE_UNITS, &units));
+
+		// Batch.shader enables its sampler cases eight at a time, GL 3.3 guarantees 16
+		unsigned int slots = units < (int)MaxBatchTextures ? (unsigned int)units : MaxBatchTextures;
+		slots &= ~7u;
+		s_MaxBatchTextures = slots < 16 ? 16 : slots;
+	}
+	return s_MaxBatchTextures;
+}
+
+float Renderer::PrepareBatchQuad(const Texture& texture)
+{
+	if (m_BatchVertices.size() >= MaxBatchQuads * 4)
+		FlushBatch();
+
+	// Searched from the back, consecutive quads mostly share the newest texture
+	for (unsigned int slot = (unsigned int)m_BatchTextures.size(); slot > 0; slot--)
+	{
+		if (m_BatchTextures[slot - 1] == &texture)
+			return (float)(slot - 1);
+	}
+
+	// Only a new texture with every slot taken breaks the batch
+	if (m_BatchTextures.size() >= GetMaxBatchTextures())
+		FlushBatch();
+
+	m_BatchTextures.push_back(&texture);
+	return (float)(m_BatchTextures.size() - 1);
+}
+
+void Renderer::DrawQuad(const glm::vec2& position, const glm::vec2& size, const Texture& texture, const glm::vec4& color)
+{
+	// Needs a new draw call only if the batch is full or out of texture slots
+	float slot = PrepareBatchQuad(texture);
+
+	// No rotation, so the corners are found without a matrix multiply
+	glm::vec2 half = size * 0.5f;
+	m_BatchVertices.push_back({ { position.x - half.x, position.y - half.y, 0.0f }, { 0.0f, 0.0f }, color, slot });
+	m_BatchVertices.push_back({ { position.x + half.x, position.y - half.y, 0.0f }, { 1.0f, 0.0f }, color, slot });
+	m_BatchVertices.push_back({ { position.x + half.x, position.y + half.y, 0.0f }, { 1.0f, 1.0f }, color, slot });
+	m_BatchVertices.push_back({ { position.x - half.x, position.y + half.y, 0.0f }, { 0.0f, 1.0f }, color, slot });
+}
+
+void Renderer::DrawQuad(const glm::mat4& transform, const Texture& texture, const glm::vec4& texRect, const glm::vec4& color)
+{
+	float slot = PrepareBatchQuad(texture);
+
+	// Corners of a unit quad centred on the origin, texRect is (u0, v0, u1, v1)
+	const glm::vec4 corners[4] = {
+		{ -0.5f, -0.5f, 0.0f, 1.0f },
+		{  0.5f, -0.5f, 0.0f, 1.0f },
+		{  0.5f,  0.5f, 0.0f, 1.0f },
+		{ -0.5f,  0.5f, 0.0f, 1.0f },
+	};
+	const glm::vec2 texCoords[4] = {
+		{ texRect.x, texRect.y },
+		{ texRect.z, texRect.y },
+		{ texRect.z, texRect.w },
+		{ texRect.x, texRect.w },
+	};
+
+	for (int i = 0; i < 4; i++)
+		m_BatchVertices.push_back({ glm::vec3(transform * corners[i]), texCoords[i], color, slot });
+}
+
+void Renderer::DrawSprites(const SpriteStore& sprites)
+{
+	DrawSprites(sprites, nullptr, sprites.GetCount());
+}
+
+void Renderer::DrawSprites(const SpriteStore& sprites, const std::vector<unsigned int>& indices)
+{
+	DrawSprites(sprites, indices.data(), (unsigned int)indices.size());
+}
+
+void Renderer::DrawSprites(const SpriteStore& sprites, const unsigned int* indices, unsigned int count)
+{
+	const glm::vec2* positions = sprites.GetPositions();
+	const glm::vec2* sizes = sprites.GetSizes();
+	const float* rotations = sprites.GetRotations();
+	const glm::vec4* texRects = sprites.GetTexRects();
+	const glm::vec4* colors = sprites.GetColors();
+	const Texture* const* textures = sprites.GetTextures();
+	const unsigned int* layers = sprites.GetLayers();
+
+	// Sorting by layer (8 bits) and then texture (16 bits) keeps each texture in one run of quads,
+	// so slots fill up slowly, and the stable sort keeps the store order inside a run
+	m_SpriteKeys.resize(count);
+	m_SpriteOrder.resize(count);
+	for (unsigned int i = 0; i < count; i++)
+	{
+		unsigned int index = indices ? indices[i] : i;
+		m_SpriteKeys[i] = ((layers[index] & 0xFF) << 16) | (textures[index]->GetRendererID() & 0xFFFF);
+		m_SpriteOrder[i] = index;
+	}
+	RadixSort(m_SpriteKeys, m_SpriteOrder, m_SpriteKeyScratch, m_SpriteOrderScratch);
+
+	for (unsigned int index : m_SpriteOrder)
+	{
+		float slot = PrepareBatchQuad(*textures[index]);
+
+		// Half extents along the rotated x and y axes, the corners are the centre plus or minus both
+		glm::vec2 half = sizes[index] * 0.5f;
+		glm::vec2 axisX(half.x, 0.0f);
+		glm::vec2 axisY(0.0f, half.y);
+		if (rotations[index] != 0.0f)
+		{
+			float c = std::cos(rotations[index]);
+			float s = std::sin(rotations[index]);
+			axisX = glm::vec2(c, s) * half.x;
+			axisY = glm::vec2(-s, c) * half.y;
+		}
+
+		const glm::vec2& p = positions[index];
+		const glm::vec4& uv = texRects[index];
+		const glm::vec4& color = colors[index];
+		m_BatchVertices.push_back({ glm::vec3(p - axisX - axisY, 0.0f), { uv.x, uv.y }, color, slot });
+		m_BatchVertices.push_back({ glm::vec3(p + axisX - axisY, 0.0f), { uv.z, uv.y }, color, slot });
+		m_BatchVertices.push_back({ glm::vec3(p + axisX + axisY, 0.0f), { uv.z, uv.w }, color, slot });
+		m_BatchVertices.push_back({ glm::vec3(p - axisX + axisY, 0.0f), { uv.x, uv.w }, color, slot });
+	}
+}
+
+void Renderer::EndBatch()
+{
+	FlushBatch();
+	m_BatchShader = nullptr;
+
+	// The ranges this batch streamed can be reused once the GPU passes this point
+	m_BatchVertexBuffer->Fence();
+}
+
+// Streams the waiting quads into the ring and draws them with one glDrawElementsBaseVertex
+void Renderer::FlushBatch()
+{
+	if (m_BatchVertices.empty())
+		return;
+
+	unsigned int quadCount = (unsigned int)m_BatchVertices.size() / 4;
+	unsigned int size = (unsigned int)(m_BatchVertices.size() * sizeof(BatchVertex));
+	void* data = m_BatchVertexBuffer->Map(size, sizeof(BatchVertex));
+	memcpy(data, m_BatchVertices.data(), size);
+	int baseVertex = (int)(m_BatchVertexBuffer->Unmap() / sizeof(BatchVertex));
+
+	for (unsigned int slot = 0; slot < m_BatchTextures.size(); slot++)
+		m_BatchTextures[slot]->Bind(slot);
+	m_BatchShader->Bind();
+	m_BatchVAO->Bind();
+	const IndexBuffer& indices = QuadIndexBuffer::Get(quadCount);
+	indices.Bind();
+	GLCall(glDrawElementsBaseVertex(GL_TRIANGLES, quadCount * 6, indices.GetType(), nullptr, baseVertex));
+
+	m_BatchStats.DrawCalls++;
+	m_BatchStats.QuadCount += quadCount;
+
+	m_BatchVertices.clear();
+	m_BatchTextures.clear();
+}
+
+void Renderer::Submit(const VertexArray& va, const IndexBuffer& ib, Shader& shader, const Texture* texture,
+	const glm::mat4& mvp, unsigned int layer, float depth)
+{
+	m_Queue.Submit({ &va, &ib, &shader, texture, mvp }, layer, depth);
+}
+
+void Renderer::SubmitTransparent(const VertexArray& va, const IndexBuffer& ib, Shader& shader, const Texture* texture,
+	const glm::mat4& mvp, unsigned int layer, float depth)
+{
+	m_TransparentQueue.Submit({ &va, &ib, &shader, texture, mvp }, layer, depth);
+}
+
+void Renderer::FlushQueue()
+{
+	m_Queue.Execute();
+	m_Queue.Clear();
+
+	// With depth testing enabled by the caller, blended objects are tested against the opaque depth but must not hide each other
+	GLCall(glDepthMask(GL_FALSE));
+	m_TransparentQueue.Execute();
+	GLCall(glDepthMask(GL_TRUE));
+	m_TransparentQueue.Clear();
 }
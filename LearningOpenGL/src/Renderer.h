@@ -2,28 +2,138 @@
 
 #include <GL/glew.h>
 
+#include <cstdint>
+#include <memory>
+#include <vector>
+
 #include "VertexArray.h"
 #include "IndexBuffer.h"
 #include "Shader.h"
+#include "RenderQueue.h"
+#include "DrawIndirectBuffer.h"
+#include "StreamingBuffer.h"
 
 // a macro to break on OpenGL error to help debugging
 #define ASSERT(x) if (!(x)) __debugbreak();
 
 // a macro to clear the errors and call glGetError on the same line.
-#define GLCall(x) GLClearError();\
+// Also breaks when called on a thread the context is not current on (see RenderThread)
+#define GLCall(x) ASSERT(GLIsContextThread());\
+	GLClearError();\
 	x;\
 	ASSERT(GLLogCall(#x, __FILE__, __LINE__))
 
 // Clears all remaining error flags in OpenGL
 void GLClearError();
 
+// True on the thread the OpenGL context is current on
+bool GLIsContextThread();
+
 // A function that indicates when and where an OpenGl error occurs
 bool GLLogCall(const char* function, const char* file, int line);
 
 
+class Texture;
+class Camera;
+class UniformBuffer;
+class SpriteStore;
+class GPUCuller;
+
+// One corner of a quad in the batch vertex buffer (see res/shaders/Batch.shader)
+struct BatchVertex
+{
+	glm::vec3 Position;
+	glm::vec2 TexCoord;
+	glm::vec4 Color;
+	// slot of the texture in the batch, a float like every other attribute
+	float TexIndex;
+};
+
+// Counts of what the batch actually sent to the GPU, summed over every flush
+struct BatchStats
+{
+	unsigned int DrawCalls = 0;
+	unsigned int QuadCount = 0;
+};
+
 class Renderer
 {
+private:
+	// quads held by the batch before it has to flush
+	static const unsigned int MaxBatchQuads = 10000;
+	// textures a batch can bind at once, never more than the state cache tracks
+	static const unsigned int MaxBatchTextures = 32;
+	static unsigned int s_MaxBatchTextures;
+
+	std::unique_ptr<VertexArray> m_BatchVAO;
+	// every flush streams its quads into the next range of the ring
+	std::unique_ptr<StreamingBuffer> m_BatchVertexBuffer;
+
+	// CPU copy of the quads waiting to be drawn
+	std::vector<BatchVertex> m_BatchVertices;
+	Shader* m_BatchShader = nullptr;
+	// texture of every slot used by the waiting quads
+	std::vector<const Texture*> m_BatchTextures;
+
+	BatchStats m_BatchStats;
+
+	// draw order of DrawSprites (plus scratch space for the radix sort)
+	std::vector<uint32_t> m_SpriteKeys, m_SpriteKeyScratch;
+	std::vector<unsigned int> m_SpriteOrder, m_SpriteOrderScratch;
+
+	RenderQueue m_Queue;
+	RenderQueue m_TransparentQueue{ RenderQueue::SortOrder::BackToFront };
+
 public:
+	// Texture slots of one batch: GL_MAX_TEXTURE_IMAGE_UNITS capped at MaxBatchTextures and rounded
+	// down to a multiple of 8. Shaders see it as MAX_TEXTURE_SLOTS
+	static unsigned int GetMaxBatchTextures();
+
 	void Clear() const;
 	void Draw(const VertexArray& va, const IndexBuffer& ib, const Shader& shader) const;
+	// Draws the mesh instanceCount times, per-instance data comes from elements pushed with a divisor
+	void DrawInstanced(const VertexArray& va, const IndexBuffer& ib, const Shader& shader, unsigned int instanceCount) const;
+	// Draws every command of an uploaded DrawIndirectBuffer, all sharing va and ib.
+	// One glMultiDrawElementsIndirect on GL 4.3, a loop of glDrawElementsBaseVertex otherwise
+	void DrawIndirect(const VertexArray& va, const IndexBuffer& ib, const Shader& shader, const DrawIndirectBuffer& draws) const;
+	// Draws the instances that survived the last GPUCuller::Cull with one glDrawElementsIndirect (GL 4.3)
+	void DrawCulled(const VertexArray& va, const IndexBuffer& ib, const Shader& shader, const GPUCuller& culler) const;
+
+	// Uploads the cached matrices of camera to a buffer made for the "Camera" block and attaches it
+	void SetCamera(const Camera& camera, UniformBuffer& cameraBuffer) const;
+
+	// Batching: quads between BeginBatch and EndBatch are drawn in as few draw calls as possible
+	void BeginBatch(Shader& shader, const glm::mat4& viewProj);
+	void BeginBatch(Shader& shader, const Camera& camera);
+	void DrawQuad(const glm::vec2& position, const glm::vec2& size, const Texture& texture,
+		const glm::vec4& color = glm::vec4(1.0f));
+	void DrawQuad(const glm::mat4& transform, const Texture& texture,
+		const glm::vec4& texRect = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f), const glm::vec4& color = glm::vec4(1.0f));
+	// Adds every sprite of the store to the batch, ordered by layer and then texture
+	void DrawSprites(const SpriteStore& sprites);
+	// Only the sprites at the given dense indices, e.g. the ones that survived culling
+	void DrawSprites(const SpriteStore& sprites, const std::vector<unsigned int>& indices);
+	void EndBatch();
+
+	inline const BatchStats& GetBatchStats() const { return m_BatchStats; }
+	inline void ResetBatchStats() { m_BatchStats = BatchStats(); }
+
+	// Queued drawing: commands are recorded now and drawn sorted by state when the queue is flushed.
+	// depth is in [0, 1], 0 being nearest to the camera
+	void Submit(const VertexArray& va, const IndexBuffer& ib, Shader& shader, const Texture* texture,
+		const glm::mat4& mvp, unsigned int layer = 0, float depth = 0.0f);
+	// Blended objects are drawn after all opaque ones, by layer and then back to front
+	void SubmitTransparent(const VertexArray& va, const IndexBuffer& ib, Shader& shader, const Texture* texture,
+		const glm::mat4& mvp, unsigned int layer = 0, float depth = 0.0f);
+	void FlushQueue();
+
+	inline const QueueStats& GetQueueStats() const { return m_Queue.GetStats(); }
+	inline const QueueStats& GetTransparentQueueStats() const { return m_TransparentQueue.GetStats(); }
+
+private:
+	void InitBatch();
+	void FlushBatch();
+	// Makes room for one more quad and returns the slot its texture will be bound to
+	float PrepareBatchQuad(const Texture& texture);
+	void DrawSprites(const SpriteStore& sprites, const unsigned int* indices, unsigned int count);
 };
\ No newline at end of file
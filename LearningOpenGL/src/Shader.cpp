@@ -1,5 +1,8 @@
 #include "Shader.h"
 #include "Renderer.h"
+#include "GLStateCache.h"
+#include "GLDeletionQueue.h"
+#include "UniformBuffer.h"
 
 #include <iostream>
 #include <fstream>
@@ -12,13 +15,33 @@ Shader::Shader(const std::string & filepath)
 	// Parses shader file into two strings for vertex and fragment shaders
 	ShaderProgramSource source = ParseShader(filepath);
 
+	// Shaders can size their sampler arrays by the texture slots of a batch
+	std::string defines = "#define MAX_TEXTURE_SLOTS " + std::to_string(Renderer::GetMaxBatchTextures()) + "\n";
+	InsertDefines(source.VertexSource, defines);
+	InsertDefines(source.FragmentSource, defines);
+	InsertDefines(source.ComputeSource, defines);
+
 	// Creating the shaders
-	m_RendererID = CreateShader(source.VertexSource, source.FragmentSource);
+	if (!source.ComputeSource.empty())
+		m_RendererID = CreateComputeShader(source.ComputeSource);
+	else
+		m_RendererID = CreateShader(source.VertexSource, source.FragmentSource);
+
+	// Every shader declaring the camera block reads it from the same binding point
+	if (m_RendererID)
+	{
+		GLCall(unsigned int cameraBlock = glGetUniformBlockIndex(m_RendererID, "Camera"));
+		if (cameraBlock != GL_INVALID_INDEX)
+		{
+			GLCall(glUniformBlockBinding(m_RendererID, cameraBlock, UniformBuffer::CameraBinding));
+		}
+	}
 }
 
 Shader::~Shader()
 {
-	GLCall(glDeleteProgram(m_RendererID));
+	// deleted once the GPU has finished the frames that may still use it
+	GLDeletionQueue::Enqueue(GLObjectType::Program, m_RendererID);
 }
 
 //Parses the file and delivers back vertex and frament strings.
@@ -30,12 +53,12 @@ ShaderProgramSource Shader::ParseShader(const std::string& filepath)
 	//our own terminology to seperate the vertex and fragment shader code
 	enum class ShaderType
 	{
-		NONE = -1, VERTEX = 0, FRAGMENT = 1
+		NONE = -1, VERTEX = 0, FRAGMENT = 1, COMPUTE = 2
 	};
 
-	//devide the file into ss[0], ss[1]
+	//devide the file into ss[0], ss[1], ss[2]
 	std::string line;
-	std::stringstream ss[2];
+	std::stringstream ss[3];
 	ShaderType type = ShaderType::NONE;
 	while (getline(stream, line))
 	{
@@ -45,13 +68,28 @@ ShaderProgramSource Shader::ParseShader(const std::string& filepath)
 				type = ShaderType::VERTEX;
 			else if (line.find("fragment") != std::string::npos)
 				type = ShaderType::FRAGMENT;
+			else if (line.find("compute") != std::string::npos)
+				type = ShaderType::COMPUTE;
 		}
-		else
+		else if (type != ShaderType::NONE)
 		{
 			ss[(int)type] << line << '\n';
 		}
 	}
-	return { ss[0].str() , ss[1].str() };
+	return { ss[0].str() , ss[1].str(), ss[2].str() };
+}
+
+void Shader::InsertDefines(std::string& source, const std::string& defines)
+{
+	size_t version = source.find("#version");
+	if (version == std::string::npos)
+		return;
+
+	// #version has to stay first, #line keeps compile errors pointing at the lines of the file
+	size_t lineEnd = source.find('\n', version);
+	if (lineEnd == std::string::npos)
+		return;
+	source.insert(lineEnd + 1, defines + "#line 2\n");
 }
 
 // Compiling a shader
@@ -86,7 +124,7 @@ unsigned int Shader::CompileShader(unsigned int type, const std::string& source)
 		GLCall(glGetShaderInfoLog(id, length, &length, message));
 
 		std::cout << "Failed to compile " <<
-			(type == GL_VERTEX_SHADER ? "vertex" : "fragment") << " shader!" << std::endl;
+			(type == GL_VERTEX_SHADER ? "vertex" : type == GL_COMPUTE_SHADER ? "compute" : "fragment") << " shader!" << std::endl;
 		std::cout << message << std::endl;
 		GLCall(glDeleteShader(id));
 		return 0;
@@ -121,14 +159,39 @@ unsigned int Shader::CreateShader(const std::string& vertexShader, const std::st
 	return program;
 }
 
+// A compute program has a single stage
+unsigned int Shader::CreateComputeShader(const std::string& computeShader)
+{
+	if (!IsComputeSupported())
+	{
+		std::cout << "Compute shaders need OpenGL 4.3: " << m_FilePath << std::endl;
+		return 0;
+	}
+
+	unsigned int program = glCreateProgram();
+	unsigned int cs = CompileShader(GL_COMPUTE_SHADER, computeShader);
+
+	GLCall(glAttachShader(program, cs));
+	GLCall(glLinkProgram(program));
+	GLCall(glValidateProgram(program));
+	GLCall(glDeleteShader(cs));
+
+	return program;
+}
+
+bool Shader::IsComputeSupported()
+{
+	return GLEW_VERSION_4_3 != 0;
+}
+
 void Shader::Bind() const
 {
-	GLCall(glUseProgram(m_RendererID));
+	GLStateCache::BindProgram(m_RendererID);
 }
 
 void Shader::Unbind() const
 {
-	GLCall(glUseProgram(0));
+	GLStateCache::BindProgram(0);
 }
 
 void Shader::SetUniform1i(const std::string & name, int value)
@@ -147,6 +210,11 @@ void Shader::SetUniform4f(const std::string & name, float v0, float v1, float v2
 	GLCall(glUniform4f(GetUniformLocation(name), v0, v1, v2, v3));
 }
 
+void Shader::SetUniform1iv(const std::string & name, unsigned int count, const int* values)
+{
+	GLCall(glUniform1iv(GetUniformLocation(name), count, values));
+}
+
 // Setting data (matrix) into new variabl "name"
 void Shader::SetUniformMat4f(const std::string & name, const glm::mat4 & matrix)
 {
@@ -6,10 +6,12 @@
 #include "glm/glm.hpp"
 
 // A struct assisting ShaderProgramSource to return two string in one function.
+// A file with a "#shader compute" section is a compute program and has no other stages.
 struct ShaderProgramSource
 {
 	std::string VertexSource;
 	std::string FragmentSource;
+	std::string ComputeSource;
 };
 
 class Shader
@@ -28,15 +30,25 @@ public:
 	void Bind() const;
 	void Unbind() const;
 
+	inline unsigned int GetRendererID() const { return m_RendererID; }
+
+	// Compute programs need GL 4.3
+	static bool IsComputeSupported();
+
 	// Set uniform ~ simplified in this series 
 	void SetUniform1i(const std::string& name, int value);
 	void SetUniform1f(const std::string& name, float value);
 	void SetUniform4f(const std::string& name, float v0, float v1, float v2, float v3);
+	// sets count elements of an int (or sampler) array starting at element 0
+	void SetUniform1iv(const std::string& name, unsigned int count, const int* values);
 	void SetUniformMat4f(const std::string& name, const glm::mat4& matrix);
 
 private:
 	ShaderProgramSource ParseShader(const std::string& filepath);
+	// Adds the engine's #defines after the #version line of a stage
+	static void InsertDefines(std::string& source, const std::string& defines);
 	unsigned int CompileShader(unsigned int type, const std::string& source);
 	unsigned int CreateShader(const std::string& vertexShader, const std::string& fragmentShader);
+	unsigned int CreateComputeShader(const std::string& computeShader);
 	int GetUniformLocation(const std::string& name);
 };
\ No newline at end of file
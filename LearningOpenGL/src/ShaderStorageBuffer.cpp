@@ -0,0 +1,52 @@
+#include "ShaderStorageBuffer.h"
+
+#include "Renderer.h"
+#include "GLStateCache.h"
+#include "GLDeletionQueue.h"
+
+ShaderStorageBuffer::ShaderStorageBuffer(const void* data, unsigned int size)
+	: m_Size(size)
+{
+	GLCall(glGenBuffers(1, &m_RendererID));
+	Bind();
+
+	// GL_DYNAMIC_COPY: written by the GPU, read by the GPU
+	GLCall(glBufferData(GL_SHADER_STORAGE_BUFFER, size, data, GL_DYNAMIC_COPY));
+}
+
+ShaderStorageBuffer::~ShaderStorageBuffer()
+{
+	// deleted once the GPU has finished the frames that may still use it
+	GLDeletionQueue::Enqueue(GLObjectType::Buffer, m_RendererID);
+}
+
+void ShaderStorageBuffer::Bind() const
+{
+	GLStateCache::BindBuffer(GL_SHADER_STORAGE_BUFFER, m_RendererID);
+}
+
+void ShaderStorageBuffer::Unbind() const
+{
+	GLStateCache::BindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+}
+
+void ShaderStorageBuffer::BindBase(unsigned int binding) const
+{
+	GLCall(glBindBufferBase(GL_SHADER_STORAGE_BUFFER, binding, m_RendererID));
+}
+
+void ShaderStorageBuffer::SetSubData(const void* data, unsigned int size, unsigned int offset)
+{
+	ASSERT(offset + size <= m_Size);
+
+	Bind();
+	GLCall(glBufferSubData(GL_SHADER_STORAGE_BUFFER, offset, size, data));
+}
+
+void ShaderStorageBuffer::GetSubData(void* data, unsigned int size, unsigned int offset) const
+{
+	ASSERT(offset + size <= m_Size);
+
+	Bind();
+	GLCall(glGetBufferSubData(GL_SHADER_STORAGE_BUFFER, offset, size, data));
+}
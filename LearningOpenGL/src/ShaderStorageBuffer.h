@@ -0,0 +1,26 @@
+#pragma once
+
+// A buffer that shaders can read and write freely (GL 4.3), e.g. input and output of compute shaders
+class ShaderStorageBuffer
+{
+private:
+	unsigned int m_RendererID;
+	unsigned int m_Size;
+
+public:
+	// data may be nullptr to leave the storage uninitialised
+	ShaderStorageBuffer(const void* data, unsigned int size);
+	~ShaderStorageBuffer();
+
+	void Bind() const;
+	void Unbind() const;
+	// Attaches the buffer to the "layout(binding = ...)" of a buffer block
+	void BindBase(unsigned int binding) const;
+
+	void SetSubData(const void* data, unsigned int size, unsigned int offset = 0);
+	// Copies GPU results back, waits for every command that writes the buffer
+	void GetSubData(void* data, unsigned int size, unsigned int offset = 0) const;
+
+	inline unsigned int GetRendererID() const { return m_RendererID; }
+	inline unsigned int GetSize() const { return m_Size; }
+};
\ No newline at end of file
@@ -0,0 +1,115 @@
+#include "SpriteStore.h"
+
+#include "Renderer.h"
+
+SpriteHandle SpriteStore::Add(const glm::vec2& position, const glm::vec2& size, const Texture& texture, float rotation,
+	const glm::vec4& texRect, const glm::vec4& color, unsigned int layer)
+{
+	// Reuse a slot of a removed sprite before growing the slot table
+	unsigned int slot;
+	if (!m_FreeSlots.empty())
+	{
+		slot = m_FreeSlots.back();
+		m_FreeSlots.pop_back();
+	}
+	else
+	{
+		slot = (unsigned int)m_SlotToDense.size();
+		m_SlotToDense.push_back(0);
+		m_SlotGenerations.push_back(0);
+	}
+
+	m_SlotToDense[slot] = GetCount();
+	m_DenseToSlot.push_back(slot);
+
+	m_Positions.push_back(position);
+	m_Sizes.push_back(size);
+	m_Rotations.push_back(rotation);
+	m_TexRects.push_back(texRect);
+	m_Colors.push_back(color);
+	m_Textures.push_back(&texture);
+	m_Layers.push_back(layer);
+
+	return { slot, m_SlotGenerations[slot] };
+}
+
+void SpriteStore::Remove(SpriteHandle sprite)
+{
+	if (!IsValid(sprite))
+		return;
+
+	unsigned int index = m_SlotToDense[sprite.Slot];
+	unsigned int last = GetCount() - 1;
+
+	// Move the last sprite into the hole and point its slot at the new place
+	if (index != last)
+	{
+		m_Positions[index] = m_Positions[last];
+		m_Sizes[index] = m_Sizes[last];
+		m_Rotations[index] = m_Rotations[last];
+		m_TexRects[index] = m_TexRects[last];
+		m_Colors[index] = m_Colors[last];
+		m_Textures[index] = m_Textures[last];
+		m_Layers[index] = m_Layers[last];
+
+		unsigned int movedSlot = m_DenseToSlot[last];
+		m_DenseToSlot[index] = movedSlot;
+		m_SlotToDense[movedSlot] = index;
+	}
+
+	m_Positions.pop_back();
+	m_Sizes.pop_back();
+	m_Rotations.pop_back();
+	m_TexRects.pop_back();
+	m_Colors.pop_back();
+	m_Textures.pop_back();
+	m_Layers.pop_back();
+	m_DenseToSlot.pop_back();
+
+	// Old handles to this slot no longer match its generation
+	m_SlotGenerations[sprite.Slot]++;
+	m_FreeSlots.push_back(sprite.Slot);
+}
+
+bool SpriteStore::IsValid(SpriteHandle sprite) const
+{
+	return sprite.Slot < m_SlotGenerations.size() && m_SlotGenerations[sprite.Slot] == sprite.Generation;
+}
+
+unsigned int SpriteStore::GetIndex(SpriteHandle sprite) const
+{
+	ASSERT(IsValid(sprite));
+	return m_SlotToDense[sprite.Slot];
+}
+
+void SpriteStore::Clear()
+{
+	// Every slot is freed, so every handle handed out so far becomes invalid
+	for (unsigned int index = 0; index < GetCount(); index++)
+	{
+		unsigned int slot = m_DenseToSlot[index];
+		m_SlotGenerations[slot]++;
+		m_FreeSlots.push_back(slot);
+	}
+
+	m_Positions.clear();
+	m_Sizes.clear();
+	m_Rotations.clear();
+	m_TexRects.clear();
+	m_Colors.clear();
+	m_Textures.clear();
+	m_Layers.clear();
+	m_DenseToSlot.clear();
+}
+
+void SpriteStore::Reserve(unsigned int count)
+{
+	m_Positions.reserve(count);
+	m_Sizes.reserve(count);
+	m_Rotations.reserve(count);
+	m_TexRects.reserve(count);
+	m_Colors.reserve(count);
+	m_Textures.reserve(count);
+	m_Layers.reserve(count);
+	m_DenseToSlot.reserve(count);
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <vector>
+
+#include "glm/glm.hpp"
+
+class Texture;
+
+// Refers to one sprite for as long as it lives, however the sprites are moved around in memory.
+// A handle of a removed sprite stays invalid even after its slot is reused.
+struct SpriteHandle
+{
+	unsigned int Slot;
+	unsigned int Generation;
+};
+
+// Every property of every sprite in its own tightly packed array, so code that touches one
+// property of all sprites (or the renderer building vertices) walks memory front to back.
+// Removing swaps the last sprite into the hole, keeping the arrays dense.
+class SpriteStore
+{
+private:
+	// dense, indexed 0..GetCount()-1
+	std::vector<glm::vec2> m_Positions;
+	std::vector<glm::vec2> m_Sizes;
+	// radians, counter clockwise
+	std::vector<float> m_Rotations;
+	// (u0, v0, u1, v1)
+	std::vector<glm::vec4> m_TexRects;
+	std::vector<glm::vec4> m_Colors;
+	std::vector<const Texture*> m_Textures;
+	std::vector<unsigned int> m_Layers;
+	// which slot each dense index belongs to
+	std::vector<unsigned int> m_DenseToSlot;
+
+	// handle slots: the dense index a slot points at, and how often the slot has been reused
+	std::vector<unsigned int> m_SlotToDense;
+	std::vector<unsigned int> m_SlotGenerations;
+	std::vector<unsigned int> m_FreeSlots;
+
+public:
+	SpriteHandle Add(const glm::vec2& position, const glm::vec2& size, const Texture& texture, float rotation = 0.0f,
+		const glm::vec4& texRect = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f), const glm::vec4& color = glm::vec4(1.0f), unsigned int layer = 0);
+	// O(1): the last sprite moves into the removed one's place
+	void Remove(SpriteHandle sprite);
+	bool IsValid(SpriteHandle sprite) const;
+
+	void Clear();
+	void Reserve(unsigned int count);
+
+	void SetPosition(SpriteHandle sprite, const glm::vec2& position) { m_Positions[GetIndex(sprite)] = position; }
+	void SetSize(SpriteHandle sprite, const glm::vec2& size) { m_Sizes[GetIndex(sprite)] = size; }
+	void SetRotation(SpriteHandle sprite, float rotation) { m_Rotations[GetIndex(sprite)] = rotation; }
+	void SetTexRect(SpriteHandle sprite, const glm::vec4& texRect) { m_TexRects[GetIndex(sprite)] = texRect; }
+	void SetColor(SpriteHandle sprite, const glm::vec4& color) { m_Colors[GetIndex(sprite)] = color; }
+	void SetTexture(SpriteHandle sprite, const Texture& texture) { m_Textures[GetIndex(sprite)] = &texture; }
+	void SetLayer(SpriteHandle sprite, unsigned int layer) { m_Layers[GetIndex(sprite)] = layer; }
+
+	// dense index of a valid handle, only stable until the next Remove
+	unsigned int GetIndex(SpriteHandle sprite) const;
+	inline unsigned int GetCount() const { return (unsigned int)m_Positions.size(); }
+
+	// Whole arrays for bulk updates and for the renderer
+	inline glm::vec2* GetPositions() { return m_Positions.data(); }
+	inline glm::vec2* GetSizes() { return m_Sizes.data(); }
+	inline float* GetRotations() { return m_Rotations.data(); }
+	inline glm::vec4* GetTexRects() { return m_TexRects.data(); }
+	inline glm::vec4* GetColors() { return m_Colors.data(); }
+
+	inline const glm::vec2* GetPositions() const { return m_Positions.data(); }
+	inline const glm::vec2* GetSizes() const { return m_Sizes.data(); }
+	inline const float* GetRotations() const { return m_Rotations.data(); }
+	inline const glm::vec4* GetTexRects() const { return m_TexRects.data(); }
+	inline const glm::vec4* GetColors() const { return m_Colors.data(); }
+	inline const Texture* const* GetTextures() const { return m_Textures.data(); }
+	inline const unsigned int* GetLayers() const { return m_Layers.data(); }
+};
\ No newline at end of file
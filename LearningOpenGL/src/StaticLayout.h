@@ -0,0 +1,119 @@
+#pragma once
+
+#include <cstdint>
+#include <utility>
+
+#include "VertexBufferLayout.h"
+
+// One attribute of a StaticLayout, everything about it known at compile time
+template<unsigned int GLType, unsigned int ComponentCount, bool IsNormalized = false, bool IsInteger = false>
+struct VertexAttrib
+{
+	static constexpr unsigned int Type = GLType;
+	static constexpr unsigned int Count = ComponentCount;
+	static constexpr bool Normalized = IsNormalized;
+	// read with glVertexAttribIPointer, the shader gets ints instead of floats
+	static constexpr bool Integer = IsInteger;
+
+	static constexpr unsigned int Size = GLType == GL_INT_2_10_10_10_REV ? 4 :
+		ComponentCount * (GLType == GL_HALF_FLOAT || GLType == GL_SHORT || GLType == GL_UNSIGNED_SHORT ? 2 :
+			GLType == GL_BYTE || GLType == GL_UNSIGNED_BYTE ? 1 : 4);
+};
+
+using Float1 = VertexAttrib<GL_FLOAT, 1>;
+using Float2 = VertexAttrib<GL_FLOAT, 2>;
+using Float3 = VertexAttrib<GL_FLOAT, 3>;
+using Float4 = VertexAttrib<GL_FLOAT, 4>;
+// the storage types of VertexFormats.h
+using Half2 = VertexAttrib<GL_HALF_FLOAT, 2>;
+using Half4 = VertexAttrib<GL_HALF_FLOAT, 4>;
+using Short2N = VertexAttrib<GL_SHORT, 2, true>;
+using Short4N = VertexAttrib<GL_SHORT, 4, true>;
+using UShort2N = VertexAttrib<GL_UNSIGNED_SHORT, 2, true>;
+using UShort4N = VertexAttrib<GL_UNSIGNED_SHORT, 4, true>;
+using UByte4N = VertexAttrib<GL_UNSIGNED_BYTE, 4, true>;
+using Packed4N = VertexAttrib<GL_INT_2_10_10_10_REV, 4, true>;
+using Int1 = VertexAttrib<GL_INT, 1, false, true>;
+using Int2 = VertexAttrib<GL_INT, 2, false, true>;
+using UInt1 = VertexAttrib<GL_UNSIGNED_INT, 1, false, true>;
+using UInt2 = VertexAttrib<GL_UNSIGNED_INT, 2, false, true>;
+
+// What VertexArray::AddBuffer reads of a StaticLayout: pointers into its constexpr tables, nothing allocated
+struct LayoutView
+{
+	const VertexBufferElement* Elements;
+	const unsigned int* Offsets;
+	unsigned int Count;
+	unsigned int Stride;
+	uint32_t Id;
+};
+
+namespace detail {
+	// bytes taken by the first count attributes
+	template<unsigned int N>
+	constexpr unsigned int SumOfFirst(const unsigned int (&sizes)[N], unsigned int count)
+	{
+		unsigned int sum = 0;
+		for (unsigned int i = 0; i < count; i++)
+			sum += sizes[i];
+		return sum;
+	}
+
+	template<unsigned int N>
+	constexpr uint32_t HashElements(const VertexBufferElement (&elements)[N], unsigned int divisor)
+	{
+		uint32_t id = LayoutIdBasis;
+		for (unsigned int i = 0; i < N; i++)
+			id = HashVertexElement(id, elements[i].type, elements[i].count, elements[i].normalized != 0, elements[i].integer, divisor);
+		return id;
+	}
+
+	template<unsigned int Divisor, typename Indices, typename... Attribs>
+	struct StaticLayoutTables;
+
+	template<unsigned int Divisor, size_t... I, typename... Attribs>
+	struct StaticLayoutTables<Divisor, std::index_sequence<I...>, Attribs...>
+	{
+		static constexpr unsigned int Sizes[] = { Attribs::Size... };
+		static constexpr unsigned int Offsets[] = { SumOfFirst(Sizes, I)... };
+		static constexpr VertexBufferElement Elements[] = {
+			{ Attribs::Type, Attribs::Count, Attribs::Normalized, Divisor, Attribs::Integer }... };
+	};
+
+	// C++14 still needs the static arrays defined outside the class
+	template<unsigned int Divisor, size_t... I, typename... Attribs>
+	constexpr unsigned int StaticLayoutTables<Divisor, std::index_sequence<I...>, Attribs...>::Sizes[];
+	template<unsigned int Divisor, size_t... I, typename... Attribs>
+	constexpr unsigned int StaticLayoutTables<Divisor, std::index_sequence<I...>, Attribs...>::Offsets[];
+	template<unsigned int Divisor, size_t... I, typename... Attribs>
+	constexpr VertexBufferElement StaticLayoutTables<Divisor, std::index_sequence<I...>, Attribs...>::Elements[];
+}
+
+// A vertex layout fixed at compile time, e.g. StaticLayout<Float2, Float2, UByte4N>.
+// Stride, offsets and id are constants and AddBuffer only walks the tables, so unlike
+// VertexBufferLayout it never touches the heap. Formats only known at runtime still use VertexBufferLayout.
+template<unsigned int Divisor, typename... Attribs>
+class StaticLayoutBase
+{
+	static_assert(sizeof...(Attribs) > 0, "a layout needs at least one attribute");
+	using Tables = detail::StaticLayoutTables<Divisor, std::make_index_sequence<sizeof...(Attribs)>, Attribs...>;
+
+public:
+	static constexpr unsigned int Count = sizeof...(Attribs);
+	static constexpr unsigned int Stride = detail::SumOfFirst(Tables::Sizes, Count);
+	static constexpr uint32_t Id = detail::HashElements(Tables::Elements, Divisor);
+
+	// byte offset of attribute index in a vertex
+	static constexpr unsigned int GetOffset(unsigned int index) { return Tables::Offsets[index]; }
+
+	static constexpr LayoutView GetView() { return { Tables::Elements, Tables::Offsets, Count, Stride, Id }; }
+	// so a layout can be passed to AddBuffer like a VertexBufferLayout: va.AddBuffer(vb, StaticLayout<Float2, Float2>())
+	constexpr operator LayoutView() const { return GetView(); }
+};
+
+template<typename... Attribs>
+using StaticLayout = StaticLayoutBase<0, Attribs...>;
+
+// Per-instance data, every attribute advances once every Divisor instances
+template<unsigned int Divisor, typename... Attribs>
+using StaticInstanceLayout = StaticLayoutBase<Divisor, Attribs...>;
\ No newline at end of file
@@ -0,0 +1,152 @@
+#include "StreamingBuffer.h"
+
+#include "Renderer.h"
+#include "GLStateCache.h"
+#include "GLDeletionQueue.h"
+
+StreamingBuffer::StreamingBuffer(unsigned int size)
+	: m_Size(size), m_Persistent(IsPersistentSupported()), m_Mapping(nullptr),
+	m_Head(0), m_FenceBegin(0), m_MappedOffset(0), m_MappedSize(0), m_WaitCount(0)
+{
+	GLCall(glGenBuffers(1, &m_RendererID));
+	Bind();
+
+	if (m_Persistent)
+	{
+		// Mapped once for the lifetime of the buffer, coherent so writes need no flush
+		GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+		GLCall(glBufferStorage(GL_ARRAY_BUFFER, size, nullptr, flags));
+		GLCall(m_Mapping = (unsigned char*)glMapBufferRange(GL_ARRAY_BUFFER, 0, size, flags));
+	}
+	else
+	{
+		// GL_STREAM_DRAW: written once, drawn a few times
+		GLCall(glBufferData(GL_ARRAY_BUFFER, size, nullptr, GL_STREAM_DRAW));
+	}
+}
+
+StreamingBuffer::~StreamingBuffer()
+{
+	for (const FencedRange& range : m_Fences)
+	{
+		GLCall(glDeleteSync((GLsync)range.Fence));
+	}
+
+	// deleted once the GPU has finished the frames that may still use it, which also unmaps it
+	GLDeletionQueue::Enqueue(GLObjectType::Buffer, m_RendererID);
+}
+
+bool StreamingBuffer::IsPersistentSupported()
+{
+	return GLEW_VERSION_4_4 || GLEW_ARB_buffer_storage;
+}
+
+void StreamingBuffer::Bind() const
+{
+	GLStateCache::BindBuffer(GL_ARRAY_BUFFER, m_RendererID);
+}
+
+void StreamingBuffer::Unbind() const
+{
+	GLStateCache::BindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void* StreamingBuffer::Map(unsigned int size, unsigned int alignment)
+{
+	ASSERT(size <= m_Size && m_MappedSize == 0);
+
+	// Ranges never wrap around the end of the buffer, what is left of it is skipped instead
+	uint64_t offset = m_Head % m_Size;
+	uint64_t aligned = (offset + alignment - 1) / alignment * alignment;
+	uint64_t begin = aligned + size <= m_Size ? m_Head - offset + aligned : m_Head - offset + m_Size;
+	bool wrapped = begin != 0 && begin % m_Size == 0;
+
+	if (m_Persistent)
+		WaitFor(begin + size);
+
+	m_MappedOffset = (unsigned int)(begin % m_Size);
+	m_MappedSize = size;
+	m_Head = begin + size;
+
+	if (m_Persistent)
+		return m_Mapping + m_MappedOffset;
+
+	// Nothing in the current storage is written twice before it is orphaned, so no synchronisation is needed
+	GLbitfield access = GL_MAP_WRITE_BIT | (wrapped ? GL_MAP_INVALIDATE_BUFFER_BIT :
+		GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+
+	Bind();
+	GLCall(void* data = glMapBufferRange(GL_ARRAY_BUFFER, m_MappedOffset, size, access));
+	return data;
+}
+
+unsigned int StreamingBuffer::Unmap()
+{
+	ASSERT(m_MappedSize != 0);
+
+	// Coherent writes are already visible to the GPU
+	if (!m_Persistent)
+	{
+		Bind();
+		GLCall(glUnmapBuffer(GL_ARRAY_BUFFER));
+	}
+
+	m_MappedSize = 0;
+	return m_MappedOffset;
+}
+
+void StreamingBuffer::Fence()
+{
+	// Orphaning already keeps the GPU's data apart on the GL 3.3 path
+	if (!m_Persistent || m_FenceBegin == m_Head)
+		return;
+
+	GLCall(GLsync fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+	m_Fences.push_back({ fence, m_FenceBegin, m_Head });
+	m_FenceBegin = m_Head;
+
+	// Ranges finish in order, drop the finished ones so the queue stays as short as the frames in flight
+	while (m_Fences.size() > 1)
+	{
+		GLCall(GLenum status = glClientWaitSync((GLsync)m_Fences.front().Fence, 0, 0));
+		if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED)
+			break;
+
+		GLCall(glDeleteSync((GLsync)m_Fences.front().Fence));
+		m_Fences.pop_front();
+	}
+}
+
+void StreamingBuffer::WaitFor(uint64_t end)
+{
+	if (end <= m_Size)
+		return;
+
+	// Everything written before limit shares its bytes with the range being mapped
+	uint64_t limit = end - m_Size;
+
+	// Still unfenced writes of this frame are about to be overwritten, fence them so they can be waited on
+	if (m_FenceBegin < limit)
+		Fence();
+
+	bool waited = false;
+	while (!m_Fences.empty() && m_Fences.front().Begin < limit)
+	{
+		GLsync fence = (GLsync)m_Fences.front().Fence;
+
+		// The first wait flushes so the fence is sure to be reached, later ones poll every millisecond
+		GLCall(GLenum status = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0));
+		while (status == GL_TIMEOUT_EXPIRED)
+		{
+			waited = true;
+			GLCall(status = glClientWaitSync(fence, 0, 1000000));
+		}
+		ASSERT(status != GL_WAIT_FAILED);
+
+		GLCall(glDeleteSync(fence));
+		m_Fences.pop_front();
+	}
+
+	if (waited)
+		m_WaitCount++;
+}
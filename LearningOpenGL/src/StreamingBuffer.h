@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+
+// One large vertex buffer that dynamic geometry is streamed through every frame, instead of
+// recreating buffers or waiting on glBufferSubData. Map hands out the next free range of the
+// ring, Unmap returns the offset draws read it from and Fence marks the end of a frame's writes.
+//
+// With GL 4.4 (or ARB_buffer_storage) the storage is immutable and mapped persistently once.
+// Every fenced range is guarded by a glFenceSync, and Map only waits when the ring wraps onto
+// a range the GPU may still be reading. On GL 3.3 each Map is an unsynchronised
+// glMapBufferRange, and wrapping orphans the whole buffer so the driver hands out new storage.
+class StreamingBuffer
+{
+private:
+	struct FencedRange
+	{
+		void* Fence;
+		// ring positions (bytes streamed since creation, never wrapped) written before the fence
+		uint64_t Begin, End;
+	};
+
+	unsigned int m_RendererID;
+	unsigned int m_Size;
+	bool m_Persistent;
+	// start of the persistent mapping, nullptr on the GL 3.3 path
+	unsigned char* m_Mapping;
+
+	// ring position of the next Map, and of the first write since the last Fence
+	uint64_t m_Head;
+	uint64_t m_FenceBegin;
+	std::deque<FencedRange> m_Fences;
+
+	// range handed out by the last Map
+	unsigned int m_MappedOffset;
+	unsigned int m_MappedSize;
+
+	// times Map had to wait for the GPU, the buffer is too small if this keeps growing
+	unsigned int m_WaitCount;
+
+public:
+	StreamingBuffer(unsigned int size);
+	~StreamingBuffer();
+
+	// Persistent mapping needs glBufferStorage (GL 4.4)
+	static bool IsPersistentSupported();
+
+	void Bind() const;
+	void Unbind() const;
+
+	// Returns where to write size bytes, at an offset that is a multiple of alignment (e.g. the vertex stride).
+	// Only one range is mapped at a time
+	void* Map(unsigned int size, unsigned int alignment = 1);
+	// Ends the writes of the last Map and returns the byte offset they start at in the buffer
+	unsigned int Unmap();
+	// Call once the draws reading everything unmapped so far have been issued, e.g. at the end of a frame
+	void Fence();
+
+	inline bool IsPersistent() const { return m_Persistent; }
+	inline unsigned int GetWaitCount() const { return m_WaitCount; }
+	inline unsigned int GetSize() const { return m_Size; }
+	inline unsigned int GetRendererID() const { return m_RendererID; }
+
+private:
+	// Blocks until the GPU no longer reads anything the ring position end would overwrite
+	void WaitFor(uint64_t end);
+};
\ No newline at end of file
@@ -1,5 +1,8 @@
 #include "Texture.h"
 
+#include "GLStateCache.h"
+#include "GLDeletionQueue.h"
+
 #include "stb_image/stb_image.h"
 
 Texture::Texture(const std::string & path)
@@ -11,11 +14,28 @@ Texture::Texture(const std::string & path)
 	// Flip image as png coordinate start top side, OpenGL starts bottom
 	m_LocalBuffer = stbi_load(path.c_str(), &m_Width, &m_Height, &m_BPP, 4);
 
+	Create(m_LocalBuffer);
+
+	// free local buffer
+	if (m_LocalBuffer)
+		stbi_image_free(m_LocalBuffer);
+	m_LocalBuffer = nullptr;
+}
+
+Texture::Texture(int width, int height, const unsigned char* pixels)
+	: m_RendererID(0), m_LocalBuffer(nullptr),
+	m_Width(width), m_Height(height), m_BPP(4)
+{
+	Create(pixels);
+}
+
+void Texture::Create(const unsigned char* pixels)
+{
 	// loading the texture
 	GLCall(glGenTextures(1, &m_RendererID));
 
 	// binding the texture
-	GLCall(glBindTexture(GL_TEXTURE_2D, m_RendererID));
+	Bind();
 
 	// Setting texture parameter
 	GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR));
@@ -24,30 +44,25 @@ Texture::Texture(const std::string & path)
 	GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE));
 
 	// give opengl the data
-	GLCall(glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, m_Width, m_Height, 0, GL_RGBA, GL_UNSIGNED_BYTE, m_LocalBuffer));
+	GLCall(glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, m_Width, m_Height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels));
 
 	// unbind texture
-	GLCall(glBindTexture(GL_TEXTURE_2D, 0));
-
-	// free local buffer
-	if (m_LocalBuffer)
-		stbi_image_free(m_LocalBuffer);
+	Unbind();
 }
 
 Texture::~Texture()
 {
-	GLCall(glDeleteTextures(1, &m_RendererID)); 
+	// deleted once the GPU has finished the frames that may still use it
+	GLDeletionQueue::Enqueue(GLObjectType::Texture, m_RendererID);
 }
 
 void Texture::Bind(unsigned int slot) const
 {
-	// selects texture slot before binding
-	GLCall(glActiveTexture(GL_TEXTURE0 + slot));
-	GLCall(glBindTexture(GL_TEXTURE_2D, m_RendererID));
-
+	// selects texture slot before binding (skipped when already bound there)
+	GLStateCache::BindTexture(slot, m_RendererID);
 }
 
 void Texture::Unbind() const
 {
-	GLCall(glBindTexture(GL_TEXTURE_2D, 0));
+	GLStateCache::UnbindTexture();
 }
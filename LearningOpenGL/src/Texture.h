@@ -11,6 +11,8 @@ private:
 	int m_Width, m_Height, m_BPP;
 public:
 	Texture(const std::string& path);
+	// A texture from RGBA8 pixels already in memory (bottom row first), e.g. a packed atlas
+	Texture(int width, int height, const unsigned char* pixels);
 	~Texture();
 
 	void Bind(unsigned int slot = 0) const;
@@ -18,4 +20,9 @@ public:
 
 	inline int GetWidth() const { return m_Width; }
 	inline int GetHeight() const { return m_Height; }
+	inline unsigned int GetRendererID() const { return m_RendererID; }
+
+private:
+	// creates the OpenGL texture from m_Width x m_Height RGBA8 pixels
+	void Create(const unsigned char* pixels);
 };
\ No newline at end of file
@@ -0,0 +1,161 @@
+#include "TransformHierarchy.h"
+
+#include <cstring>
+
+#include <emmintrin.h>
+
+// result = a * b for column major matrices, one column of the result per iteration.
+// result must not be a or b
+static void MultiplyMatrix(const glm::mat4& a, const glm::mat4& b, glm::mat4& result)
+{
+	const float* lhs = &a[0][0];
+	const float* rhs = &b[0][0];
+	float* out = &result[0][0];
+
+	__m128 column0 = _mm_loadu_ps(lhs);
+	__m128 column1 = _mm_loadu_ps(lhs + 4);
+	__m128 column2 = _mm_loadu_ps(lhs + 8);
+	__m128 column3 = _mm_loadu_ps(lhs + 12);
+
+	for (int i = 0; i < 4; i++)
+	{
+		const float* column = rhs + i * 4;
+		__m128 sum = _mm_mul_ps(column0, _mm_set1_ps(column[0]));
+		sum = _mm_add_ps(sum, _mm_mul_ps(column1, _mm_set1_ps(column[1])));
+		sum = _mm_add_ps(sum, _mm_mul_ps(column2, _mm_set1_ps(column[2])));
+		sum = _mm_add_ps(sum, _mm_mul_ps(column3, _mm_set1_ps(column[3])));
+		_mm_storeu_ps(out + i * 4, sum);
+	}
+}
+
+// translate * rotate * scale, built directly instead of with two matrix multiplies
+static glm::mat4 ComposeTransform(const glm::vec3& translation, const glm::quat& rotation, const glm::vec3& scale)
+{
+	glm::mat4 transform = glm::mat4_cast(rotation);
+	transform[0] *= scale.x;
+	transform[1] *= scale.y;
+	transform[2] *= scale.z;
+	transform[3] = glm::vec4(translation, 1.0f);
+	return transform;
+}
+
+TransformHierarchy::TransformHierarchy()
+	: m_FirstDirty(0), m_LastUpdated(0)
+{
+}
+
+unsigned int TransformHierarchy::Add(unsigned int parent, const glm::vec3& translation, const glm::quat& rotation, const glm::vec3& scale)
+{
+	unsigned int node = GetCount();
+	if (parent != NoParent && parent >= node)
+	{
+		// a parent added later would break the front to back update order
+		parent = NoParent;
+	}
+
+	m_Translations.push_back(translation);
+	m_Rotations.push_back(rotation);
+	m_Scales.push_back(scale);
+	m_Parents.push_back(parent);
+	m_Locals.push_back(glm::mat4(1.0f));
+	m_Worlds.push_back(glm::mat4(1.0f));
+	m_Dirty.push_back(0);
+
+	MarkDirty(node);
+	return node;
+}
+
+void TransformHierarchy::Clear()
+{
+	m_Translations.clear();
+	m_Rotations.clear();
+	m_Scales.clear();
+	m_Parents.clear();
+	m_Locals.clear();
+	m_Worlds.clear();
+	m_Dirty.clear();
+
+	m_FirstDirty = 0;
+	m_LastUpdated = 0;
+}
+
+void TransformHierarchy::Reserve(unsigned int count)
+{
+	m_Translations.reserve(count);
+	m_Rotations.reserve(count);
+	m_Scales.reserve(count);
+	m_Parents.reserve(count);
+	m_Locals.reserve(count);
+	m_Worlds.reserve(count);
+	m_Dirty.reserve(count);
+}
+
+void TransformHierarchy::SetTranslation(unsigned int node, const glm::vec3& translation)
+{
+	if (m_Translations[node] == translation)
+		return;
+
+	m_Translations[node] = translation;
+	MarkDirty(node);
+}
+
+void TransformHierarchy::SetRotation(unsigned int node, const glm::quat& rotation)
+{
+	if (m_Rotations[node] == rotation)
+		return;
+
+	m_Rotations[node] = rotation;
+	MarkDirty(node);
+}
+
+void TransformHierarchy::SetScale(unsigned int node, const glm::vec3& scale)
+{
+	if (m_Scales[node] == scale)
+		return;
+
+	m_Scales[node] = scale;
+	MarkDirty(node);
+}
+
+void TransformHierarchy::MarkDirty(unsigned int node)
+{
+	m_Dirty[node] |= LocalDirty | WorldDirty;
+	if (node < m_FirstDirty)
+		m_FirstDirty = node;
+}
+
+unsigned int TransformHierarchy::Update()
+{
+	unsigned int count = GetCount();
+	m_LastUpdated = 0;
+
+	// Parents come first, so by the time a node is reached its parent is final
+	// and a moved parent has already passed its flag on
+	for (unsigned int node = m_FirstDirty; node < count; node++)
+	{
+		unsigned int parent = m_Parents[node];
+		if (parent != NoParent && (m_Dirty[parent] & WorldDirty))
+			m_Dirty[node] |= WorldDirty;
+
+		uint8_t dirty = m_Dirty[node];
+		if (!dirty)
+			continue;
+
+		// a node that only moved with its parent keeps its local matrix
+		if (dirty & LocalDirty)
+			m_Locals[node] = ComposeTransform(m_Translations[node], m_Rotations[node], m_Scales[node]);
+
+		if (parent == NoParent)
+			m_Worlds[node] = m_Locals[node];
+		else
+			MultiplyMatrix(m_Worlds[parent], m_Locals[node], m_Worlds[node]);
+
+		m_LastUpdated++;
+	}
+
+	if (m_FirstDirty < count)
+		std::memset(&m_Dirty[m_FirstDirty], 0, count - m_FirstDirty);
+	m_FirstDirty = count;
+
+	return m_LastUpdated;
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "glm/glm.hpp"
+#include "glm/gtc/quaternion.hpp"
+
+// Local translation, rotation and scale of many nodes and the world matrices they add up to.
+// Every property lives in its own array and a parent always comes before its children,
+// so Update is one pass from front to back that only touches nodes that moved, or whose
+// ancestors moved, since the last Update.
+class TransformHierarchy
+{
+public:
+	// parent of root nodes
+	static const unsigned int NoParent = 0xFFFFFFFF;
+
+private:
+	enum DirtyFlags : uint8_t
+	{
+		LocalDirty = 1, WorldDirty = 2
+	};
+
+	std::vector<glm::vec3> m_Translations;
+	std::vector<glm::quat> m_Rotations;
+	std::vector<glm::vec3> m_Scales;
+	std::vector<unsigned int> m_Parents;
+	std::vector<glm::mat4> m_Locals;
+	std::vector<glm::mat4> m_Worlds;
+	std::vector<uint8_t> m_Dirty;
+
+	// nothing before this node needs updating
+	unsigned int m_FirstDirty;
+	unsigned int m_LastUpdated;
+
+public:
+	TransformHierarchy();
+
+	// The parent has to exist already, which keeps parents ahead of their children. Returns the new node
+	unsigned int Add(unsigned int parent = NoParent, const glm::vec3& translation = glm::vec3(0.0f),
+		const glm::quat& rotation = glm::quat(1.0f, 0.0f, 0.0f, 0.0f), const glm::vec3& scale = glm::vec3(1.0f));
+	void Clear();
+	void Reserve(unsigned int count);
+
+	// Setters only mark the node when the value really changes
+	void SetTranslation(unsigned int node, const glm::vec3& translation);
+	void SetRotation(unsigned int node, const glm::quat& rotation);
+	void SetScale(unsigned int node, const glm::vec3& scale);
+
+	inline const glm::vec3& GetTranslation(unsigned int node) const { return m_Translations[node]; }
+	inline const glm::quat& GetRotation(unsigned int node) const { return m_Rotations[node]; }
+	inline const glm::vec3& GetScale(unsigned int node) const { return m_Scales[node]; }
+	inline unsigned int GetParent(unsigned int node) const { return m_Parents[node]; }
+
+	// Recomputes the world matrices of changed subtrees and returns how many nodes it touched
+	unsigned int Update();
+
+	// only up to date after Update
+	inline const glm::mat4& GetWorldMatrix(unsigned int node) const { return m_Worlds[node]; }
+	inline const glm::mat4* GetWorldMatrices() const { return m_Worlds.data(); }
+
+	inline unsigned int GetCount() const { return (unsigned int)m_Parents.size(); }
+	inline unsigned int GetLastUpdatedCount() const { return m_LastUpdated; }
+
+private:
+	void MarkDirty(unsigned int node);
+};
\ No newline at end of file
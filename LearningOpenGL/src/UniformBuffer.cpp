@@ -0,0 +1,35 @@
+#include "UniformBuffer.h"
+
+#include "Renderer.h"
+#include "GLStateCache.h"
+#include "GLDeletionQueue.h"
+
+UniformBuffer::UniformBuffer(unsigned int size, unsigned int binding)
+	: m_Size(size), m_Binding(binding)
+{
+	GLCall(glGenBuffers(1, &m_RendererID));
+	GLStateCache::BindBuffer(GL_UNIFORM_BUFFER, m_RendererID);
+
+	// Rewritten every frame
+	GLCall(glBufferData(GL_UNIFORM_BUFFER, size, nullptr, GL_DYNAMIC_DRAW));
+	Bind();
+}
+
+UniformBuffer::~UniformBuffer()
+{
+	// deleted once the GPU has finished the frames that may still use it
+	GLDeletionQueue::Enqueue(GLObjectType::Buffer, m_RendererID);
+}
+
+void UniformBuffer::Bind() const
+{
+	GLCall(glBindBufferBase(GL_UNIFORM_BUFFER, m_Binding, m_RendererID));
+}
+
+void UniformBuffer::SetData(const void * data, unsigned int size, unsigned int offset)
+{
+	ASSERT(offset + size <= m_Size);
+
+	GLStateCache::BindBuffer(GL_UNIFORM_BUFFER, m_RendererID);
+	GLCall(glBufferSubData(GL_UNIFORM_BUFFER, offset, size, data));
+}
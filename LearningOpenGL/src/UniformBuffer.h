@@ -0,0 +1,38 @@
+#pragma once
+
+#include "glm/glm.hpp"
+
+// Contents of the "Camera" block, laid out as std140 (mat4 columns are already 16 byte aligned):
+// layout(std140) uniform Camera { mat4 u_Projection; mat4 u_View; mat4 u_ViewProjection; };
+struct CameraUniforms
+{
+	glm::mat4 Projection;
+	glm::mat4 View;
+	glm::mat4 ViewProjection;
+};
+
+// A buffer of uniforms attached to a binding point that any number of shaders read from,
+// so shared values are uploaded once instead of once per shader and draw.
+class UniformBuffer
+{
+private:
+	unsigned int m_RendererID;
+	unsigned int m_Size;
+	unsigned int m_Binding;
+
+public:
+	// Binding points with a fixed meaning, Shader connects blocks with these names automatically
+	static const unsigned int CameraBinding = 0;
+
+	// Allocates size bytes and attaches them to binding point binding
+	UniformBuffer(unsigned int size, unsigned int binding);
+	~UniformBuffer();
+
+	// Attaches the buffer to its binding point again, e.g. after another buffer took it
+	void Bind() const;
+
+	void SetData(const void* data, unsigned int size, unsigned int offset = 0);
+
+	inline unsigned int GetBinding() const { return m_Binding; }
+	inline unsigned int GetSize() const { return m_Size; }
+};
\ No newline at end of file
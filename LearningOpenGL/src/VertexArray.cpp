@@ -1,51 +1,194 @@
 #include "VertexArray.h"
 #include "VertexBufferLayout.h"
+#include "StaticLayout.h"
+#include "StreamingBuffer.h"
 
 #include "Renderer.h"
+#include "GLStateCache.h"
+#include "GLDeletionQueue.h"
+
+#include <iostream>
 
 
 VertexArray::VertexArray()
+	: m_DirectStateAccess(IsDirectStateAccessSupported()), m_AttribCount(0), m_LayoutId(LayoutIdBasis)
 {
-	GLCall(glGenVertexArrays(1, &m_RendererID));
+	if (m_DirectStateAccess)
+	{
+		// created right away, so it can be edited before it was ever bound
+		GLCall(glCreateVertexArrays(1, &m_RendererID));
+	}
+	else
+	{
+		GLCall(glGenVertexArrays(1, &m_RendererID));
+	}
 }
 
 VertexArray::~VertexArray()
 {
-	GLCall(glDeleteVertexArrays(1, &m_RendererID));
+	// deleted once the GPU has finished the frames that may still use it
+	GLDeletionQueue::Enqueue(GLObjectType::VertexArray, m_RendererID);
+}
+
+bool VertexArray::IsDirectStateAccessSupported()
+{
+	return GLEW_VERSION_4_5 || GLEW_ARB_direct_state_access;
 }
 
 void VertexArray::AddBuffer(const VertexBuffer & vb, const VertexBufferLayout & layout)
 {
-	// binds vertex array and vertex buffer
-	Bind();
-	vb.Bind();
+	SetVertexBuffer(AddFormat(layout), vb);
+}
 
-	// adds vertex buffer layout per element
+void VertexArray::AddBuffer(const StreamingBuffer& sb, const VertexBufferLayout& layout)
+{
+	SetVertexBuffer(AddFormat(layout), sb);
+}
+
+void VertexArray::AddBuffer(const VertexBuffer& vb, const LayoutView& layout)
+{
+	SetVertexBuffer(AddFormat(layout), vb);
+}
+
+void VertexArray::AddBuffer(const StreamingBuffer& sb, const LayoutView& layout)
+{
+	SetVertexBuffer(AddFormat(layout), sb);
+}
+
+unsigned int VertexArray::AddFormat(const VertexBufferLayout& layout)
+{
+	// offsets follow the elements in order
 	const auto& elements = layout.GetElements();
+	std::vector<unsigned int> offsets(elements.size());
 	unsigned int offset = 0; 
 	for (unsigned int i = 0; i < elements.size(); i++)
 	{
-		const auto& element = elements[i];
+		offsets[i] = offset;
+		offset += elements[i].GetSize();
+	}
+
+	return AddBinding(elements.data(), offsets.data(), (unsigned int)elements.size(), layout.GetStride(), layout.GetId());
+}
 
-		// The vertex attributes (vertex data layout) binds to index i of currently bound vertex array
-		GLCall(glVertexAttribPointer(i, element.count, element.type, 
-			element.normalized, layout.GetStride(), (const void*) offset));
+unsigned int VertexArray::AddFormat(const LayoutView& layout)
+{
+	// offsets were worked out by the compiler
+	return AddBinding(layout.Elements, layout.Offsets, layout.Count, layout.Stride, layout.Id);
+}
 
-		// Recalculate offset
-		offset += element.count * VertexBufferElement::GetSizedOfType(element.type);
+unsigned int VertexArray::AddBinding(const VertexBufferElement* elements, const unsigned int* offsets, unsigned int count,
+	unsigned int stride, uint32_t layoutId)
+{
+	// the attributes of every binding come after the attributes of earlier ones
+	Binding binding;
+	binding.FirstAttrib = m_AttribCount;
+	binding.Stride = stride;
+	binding.Divisor = count ? elements[0].divisor : 0;
+	binding.Attribs.reserve(count);
+	for (unsigned int i = 0; i < count; i++)
+	{
+		// The divisor belongs to the binding, a mixed layout would silently step some attributes at the wrong rate
+		const VertexBufferElement& element = elements[i];
+		ASSERT(element.divisor == binding.Divisor);
+
+		binding.Attribs.push_back({ element.type, element.count, offsets[i], element.normalized != 0, element.integer });
+	}
 
-		// Enables vertex array index i vertex attribute (vertex data layout)
-		GLCall(glEnableVertexAttribArray(i));
+	unsigned int index = (unsigned int)m_Bindings.size();
+	if (m_DirectStateAccess)
+	{
+		// The formats are set once here, buffers are only ever swapped underneath them
+		for (unsigned int i = 0; i < count; i++)
+		{
+			const AttribFormat& format = binding.Attribs[i];
+			unsigned int attrib = binding.FirstAttrib + i;
+			if (format.Integer)
+			{
+				GLCall(glVertexArrayAttribIFormat(m_RendererID, attrib, format.Count, format.Type, format.Offset));
+			}
+			else
+			{
+				GLCall(glVertexArrayAttribFormat(m_RendererID, attrib, format.Count, format.Type,
+					format.Normalized, format.Offset));
+			}
+			GLCall(glVertexArrayAttribBinding(m_RendererID, attrib, index));
+			GLCall(glEnableVertexArrayAttrib(m_RendererID, attrib));
+		}
+		GLCall(glVertexArrayBindingDivisor(m_RendererID, index, binding.Divisor));
+	}
+
+	m_AttribCount += count;
+	m_LayoutId = (m_LayoutId ^ layoutId) * 16777619u;
+	m_Bindings.push_back(std::move(binding));
+	return index;
+}
+
+void VertexArray::SetVertexBuffer(unsigned int binding, const VertexBuffer& vb, unsigned int offset)
+{
+	SetBuffer(binding, vb.GetRendererID(), offset);
+}
+
+void VertexArray::SetVertexBuffer(unsigned int binding, const StreamingBuffer& sb, unsigned int offset)
+{
+	// Attributes start at the given offset of the ring, draws pick their range with a base vertex
+	SetBuffer(binding, sb.GetRendererID(), offset);
+}
+
+void VertexArray::SetBuffer(unsigned int binding, unsigned int bufferID, unsigned int offset)
+{
+	if (binding >= m_Bindings.size())
+	{
+		std::cout << "[VertexArray] no binding " << binding << ", add a format first" << std::endl;
+		return;
+	}
+	const Binding& b = m_Bindings[binding];
+
+	if (m_DirectStateAccess)
+	{
+		// nothing is bound, the vertex array only changes which buffer the binding reads
+		GLCall(glVertexArrayVertexBuffer(m_RendererID, binding, bufferID, offset, b.Stride));
+		return;
+	}
+
+	// The buffer is baked into every attribute pointer, so all of them are set again
+	Bind();
+	GLStateCache::BindBuffer(GL_ARRAY_BUFFER, bufferID);
+	for (unsigned int i = 0; i < b.Attribs.size(); i++)
+		SetAttribute(b.FirstAttrib + i, b.Attribs[i], b.Stride, offset + b.Attribs[i].Offset, b.Divisor);
+}
+
+void VertexArray::SetAttribute(unsigned int index, const AttribFormat& format, unsigned int stride, unsigned int offset,
+	unsigned int divisor)
+{
+	// The vertex attributes (vertex data layout) binds to index of currently bound vertex array
+	if (format.Integer)
+	{
+		// integer attributes skip the conversion to float
+		GLCall(glVertexAttribIPointer(index, format.Count, format.Type,
+			stride, (const void*) offset));
+	}
+	else
+	{
+		GLCall(glVertexAttribPointer(index, format.Count, format.Type,
+			format.Normalized, stride, (const void*) offset));
+	}
+
+	// Per-instance elements move to the next value every divisor instances
+	if (divisor)
+	{
+		GLCall(glVertexAttribDivisor(index, divisor));
 	}
 
+	// Enables vertex array index vertex attribute (vertex data layout)
+	GLCall(glEnableVertexAttribArray(index));
 }
 
 void VertexArray::Bind() const
 {
-	GLCall(glBindVertexArray(m_RendererID));
+	GLStateCache::BindVertexArray(m_RendererID);
 }
 
 void VertexArray::Unbind() const
 {
-	GLCall(glBindVertexArray(0));
+	GLStateCache::BindVertexArray(0);
 }
@@ -2,19 +2,92 @@
 
 #include "VertexBuffer.h"
 
+#include <cstdint>
+#include <vector>
+
 
 class VertexBufferLayout;
+class StreamingBuffer;
+struct VertexBufferElement;
+struct LayoutView;
 
+// Attribute formats and the buffers they read from are kept apart: a format is added once per
+// buffer binding and SetVertexBuffer swaps the buffer behind it, so meshes sharing a vertex format
+// can share one vertex array. On GL 4.5 (or ARB_direct_state_access) the vertex array is edited
+// without binding it, otherwise it is bound and the attribute pointers are set again.
 class VertexArray
 {
 private:
+	// what glVertexArrayAttribFormat takes, kept for contexts that only have glVertexAttribPointer
+	struct AttribFormat
+	{
+		unsigned int Type;
+		unsigned int Count;
+		// relative to the start of the vertex
+		unsigned int Offset;
+		bool Normalized;
+		bool Integer;
+	};
+
+	// the attributes fed by one buffer binding
+	struct Binding
+	{
+		unsigned int FirstAttrib;
+		unsigned int Stride;
+		// per binding, like in glVertexArrayBindingDivisor
+		unsigned int Divisor;
+		std::vector<AttribFormat> Attribs;
+	};
+
 	unsigned int m_RendererID;
+	bool m_DirectStateAccess;
+
+	std::vector<Binding> m_Bindings;
+
+	// next free attribute index, so every added buffer gets its own attributes
+	unsigned int m_AttribCount;
+	// ids of the layouts of every added buffer folded together
+	uint32_t m_LayoutId;
 public:
 	VertexArray();
 	~VertexArray();
 
 	void AddBuffer(const VertexBuffer& vb, const VertexBufferLayout& layout);
+	// Attributes start at offset 0 of the ring, draws pick their range with a base vertex
+	void AddBuffer(const StreamingBuffer& sb, const VertexBufferLayout& layout);
+	// Compile-time layouts (StaticLayout.h), applied without building or copying anything
+	void AddBuffer(const VertexBuffer& vb, const LayoutView& layout);
+	void AddBuffer(const StreamingBuffer& sb, const LayoutView& layout);
+
+	// Adds the attributes of a layout on a new binding without a buffer and returns the binding.
+	// Nothing may be drawn before SetVertexBuffer attached a buffer to it
+	unsigned int AddFormat(const VertexBufferLayout& layout);
+	unsigned int AddFormat(const LayoutView& layout);
+	// Points a binding at another buffer, the attribute formats stay as they are.
+	// offset is in bytes from the start of the buffer
+	void SetVertexBuffer(unsigned int binding, const VertexBuffer& vb, unsigned int offset = 0);
+	void SetVertexBuffer(unsigned int binding, const StreamingBuffer& sb, unsigned int offset = 0);
 
 	void Bind() const;
 	void Unbind() const;
+
+	// GL 4.5 or ARB_direct_state_access
+	static bool IsDirectStateAccessSupported();
+
+	inline unsigned int GetRendererID() const { return m_RendererID; }
+	inline unsigned int GetBindingCount() const { return (unsigned int)m_Bindings.size(); }
+	inline bool IsDirectStateAccess() const { return m_DirectStateAccess; }
+	// the attribute index the next added buffer will start at
+	inline unsigned int GetAttribCount() const { return m_AttribCount; }
+	// equal for vertex arrays whose buffers were added with equal layouts in the same order
+	inline uint32_t GetLayoutId() const { return m_LayoutId; }
+
+private:
+	// Records a binding for the elements and, with direct state access, sets up their formats
+	unsigned int AddBinding(const VertexBufferElement* elements, const unsigned int* offsets, unsigned int count,
+		unsigned int stride, uint32_t layoutId);
+	void SetBuffer(unsigned int binding, unsigned int bufferID, unsigned int offset);
+	// Without direct state access: points one attribute at the array buffer bound right now
+	void SetAttribute(unsigned int index, const AttribFormat& format, unsigned int stride, unsigned int offset,
+		unsigned int divisor);
 };
\ No newline at end of file
@@ -1,25 +1,65 @@
 #include "VertexBuffer.h"
 
 #include "Renderer.h"
+#include "GLStateCache.h"
+#include "GLDeletionQueue.h"
 
-VertexBuffer::VertexBuffer(const void * data, unsigned int size)
+VertexBuffer::VertexBuffer(const void * data, unsigned int size, BufferUsage usage)
+	: m_Size(size), m_Usage(usage)
 {
 	GLCall(glGenBuffers(1, &m_RendererID));
-	GLCall(glBindBuffer(GL_ARRAY_BUFFER, m_RendererID));
-	GLCall(glBufferData(GL_ARRAY_BUFFER, size, data, GL_STATIC_DRAW));
+	Bind();
+	GLCall(glBufferData(GL_ARRAY_BUFFER, size, data, GetGLUsage(usage)));
+}
+
+VertexBuffer::VertexBuffer(unsigned int size, BufferUsage usage)
+	: m_Size(size), m_Usage(usage)
+{
+	GLCall(glGenBuffers(1, &m_RendererID));
+	Bind();
+
+	// No data yet, the usage hints how often the contents will be rewritten
+	GLCall(glBufferData(GL_ARRAY_BUFFER, size, nullptr, GetGLUsage(usage)));
 }
 
 VertexBuffer::~VertexBuffer()
 {
-	GLCall(glDeleteBuffers(1, &m_RendererID))
+	// deleted once the GPU has finished the frames that may still use it
+	GLDeletionQueue::Enqueue(GLObjectType::Buffer, m_RendererID);
 }
 
 void VertexBuffer::Bind() const
 {
-	GLCall(glBindBuffer(GL_ARRAY_BUFFER, m_RendererID));
+	GLStateCache::BindBuffer(GL_ARRAY_BUFFER, m_RendererID);
 }
 
 void VertexBuffer::Unbind() const
 {
-	GLCall(glBindBuffer(GL_ARRAY_BUFFER, 0));
+	GLStateCache::BindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void VertexBuffer::SetData(const void * data, unsigned int size)
+{
+	// the vertex arrays using this buffer keep pointing at it, only the storage behind the name changes
+	Bind();
+	GLCall(glBufferData(GL_ARRAY_BUFFER, size, data, GetGLUsage(m_Usage)));
+	m_Size = size;
+}
+
+void VertexBuffer::SetSubData(const void * data, unsigned int size, unsigned int offset, BufferUpdate update)
+{
+	Bind();
+	UpdateBuffer(GL_ARRAY_BUFFER, data, size, offset, m_Size, m_Usage, update);
+}
+
+void* VertexBuffer::Map(unsigned int size, unsigned int offset, BufferUpdate update)
+{
+	Bind();
+	return MapBuffer(GL_ARRAY_BUFFER, size, offset, m_Size, update);
+}
+
+void VertexBuffer::Unmap()
+{
+	Bind();
+	GLCall(glUnmapBuffer(GL_ARRAY_BUFFER));
 }
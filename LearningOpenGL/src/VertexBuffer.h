@@ -1,14 +1,34 @@
 #pragma once
 
+#include "BufferUsage.h"
+
 
 class VertexBuffer
 {
 private:
 	unsigned int m_RendererID;
+	unsigned int m_Size;
+	BufferUsage m_Usage;
 public:
-	VertexBuffer(const void* data, unsigned int size);
+	VertexBuffer(const void* data, unsigned int size, BufferUsage usage = BufferUsage::Static);
+	// Allocates an empty buffer of size bytes to be filled each frame with SetSubData
+	VertexBuffer(unsigned int size, BufferUsage usage = BufferUsage::Dynamic);
 	~VertexBuffer();
 
 	void Bind() const;
 	void Unbind() const;
+
+	// Replaces the whole storage, size may differ from before. data may be nullptr to leave it uninitialised
+	void SetData(const void* data, unsigned int size);
+	// Overwrites part of the existing storage without reallocating it
+	void SetSubData(const void* data, unsigned int size, unsigned int offset = 0,
+		BufferUpdate update = BufferUpdate::SubData);
+
+	// Returns where to write size bytes at offset, until Unmap. Only one range is mapped at a time
+	void* Map(unsigned int size, unsigned int offset = 0, BufferUpdate update = BufferUpdate::SubData);
+	void Unmap();
+
+	inline unsigned int GetSize() const { return m_Size; }
+	inline BufferUsage GetUsage() const { return m_Usage; }
+	inline unsigned int GetRendererID() const { return m_RendererID; }
 };
\ No newline at end of file
@@ -1,7 +1,9 @@
 #pragma once
 
+#include <cstdint>
 #include <vector>
 #include "Renderer.h"
+#include "VertexFormats.h"
 
 
 struct VertexBufferElement
@@ -9,6 +11,10 @@ struct VertexBufferElement
 	unsigned int type;
 	unsigned int count;
 	unsigned char normalized;
+	// 0 advances per vertex, N advances once every N instances
+	unsigned int divisor;
+	// read as ivec/uvec by the shader (glVertexAttribIPointer) instead of being converted to float
+	bool integer = false;
 
 	static unsigned int GetSizedOfType(unsigned int type)
 	{
@@ -16,13 +22,37 @@ struct VertexBufferElement
 		{
 		case GL_FLOAT:			return 4;
 		case GL_UNSIGNED_INT:	return 4;
+		case GL_INT:			return 4;
+		case GL_HALF_FLOAT:		return 2;
+		case GL_SHORT:			return 2;
+		case GL_UNSIGNED_SHORT:	return 2;
 		case GL_UNSIGNED_BYTE:	return 1;
+		case GL_BYTE:			return 1;
+		// all four components together
+		case GL_INT_2_10_10_10_REV:	return 4;
 		}
 		ASSERT(false);
 		return 0;  
 	}
+
+	// bytes the element takes in a vertex
+	unsigned int GetSize() const
+	{
+		return type == GL_INT_2_10_10_10_REV ? 4 : count * GetSizedOfType(type);
+	}
 };
 
+// Layout ids: every element is folded into an FNV-1a hash, so equal formats get equal ids
+// whether the layout is built at runtime or at compile time (see StaticLayout.h)
+const uint32_t LayoutIdBasis = 2166136261u;
+
+constexpr uint32_t HashVertexElement(uint32_t hash, unsigned int type, unsigned int count,
+	bool normalized, bool integer, unsigned int divisor)
+{
+	return (((((hash ^ type) * 16777619u ^ count) * 16777619u ^ (normalized ? 1u : 0u)) * 16777619u
+		^ (integer ? 1u : 0u)) * 16777619u ^ divisor) * 16777619u;
+}
+
 class VertexBufferLayout
 {
 private:
@@ -33,33 +63,109 @@ public:
 	VertexBufferLayout()
 		: m_Stride(0) {}
 
+	// divisor > 0 makes the element per-instance data for instanced drawing. A layout becomes one
+	// buffer binding with a single divisor, so per-vertex and per-instance data go in separate layouts
 	template<typename T>
-	void Push(unsigned int count)
+	void Push(unsigned int count, unsigned int divisor = 0)
 	{
 		static_assert(false);
 	}
 
 	template<>
-	void Push<float>(unsigned int count)
+	void Push<float>(unsigned int count, unsigned int divisor)
 	{
-		m_Elements.push_back({ GL_FLOAT, count, GL_FALSE });
+		m_Elements.push_back({ GL_FLOAT, count, GL_FALSE, divisor });
 		m_Stride += count * VertexBufferElement::GetSizedOfType(GL_FLOAT);
 	}
 
 	template<>
-	void Push<unsigned int>(unsigned int count)
+	void Push<unsigned int>(unsigned int count, unsigned int divisor)
+	{
+		m_Elements.push_back({ GL_UNSIGNED_INT, count, GL_FALSE, divisor });
+		m_Stride += count * VertexBufferElement::GetSizedOfType(GL_UNSIGNED_INT);
+	}
+
+	template<>
+	void Push<unsigned char>(unsigned int count, unsigned int divisor)
+	{
+		m_Elements.push_back({ GL_UNSIGNED_BYTE, count, GL_TRUE, divisor });
+		m_Stride += count * VertexBufferElement::GetSizedOfType(GL_UNSIGNED_BYTE);
+	}
+
+	template<>
+	void Push<Half>(unsigned int count, unsigned int divisor)
+	{
+		m_Elements.push_back({ GL_HALF_FLOAT, count, GL_FALSE, divisor });
+		m_Stride += count * VertexBufferElement::GetSizedOfType(GL_HALF_FLOAT);
+	}
+
+	template<>
+	void Push<SNorm16>(unsigned int count, unsigned int divisor)
+	{
+		m_Elements.push_back({ GL_SHORT, count, GL_TRUE, divisor });
+		m_Stride += count * VertexBufferElement::GetSizedOfType(GL_SHORT);
+	}
+
+	template<>
+	void Push<UNorm16>(unsigned int count, unsigned int divisor)
 	{
-		m_Elements.push_back({ GL_UNSIGNED_INT, count, GL_FALSE });
+		m_Elements.push_back({ GL_UNSIGNED_SHORT, count, GL_TRUE, divisor });
+		m_Stride += count * VertexBufferElement::GetSizedOfType(GL_UNSIGNED_SHORT);
+	}
+
+	// count is the number of PackedNormals, OpenGL always reads one as four components
+	template<>
+	void Push<PackedNormal>(unsigned int count, unsigned int divisor)
+	{
+		ASSERT(count == 1);
+		m_Elements.push_back({ GL_INT_2_10_10_10_REV, 4, GL_TRUE, divisor });
+		m_Stride += VertexBufferElement::GetSizedOfType(GL_INT_2_10_10_10_REV);
+	}
+
+	// Integer attributes keep their exact value in the shader (int, uint, ivec2, ...), e.g. for
+	// indices and flags. Push<unsigned int> on the other hand turns the values into floats
+	template<typename T>
+	void PushInteger(unsigned int count, unsigned int divisor = 0)
+	{
+		static_assert(false);
+	}
+
+	template<>
+	void PushInteger<int>(unsigned int count, unsigned int divisor)
+	{
+		m_Elements.push_back({ GL_INT, count, GL_FALSE, divisor, true });
+		m_Stride += count * VertexBufferElement::GetSizedOfType(GL_INT);
+	}
+
+	template<>
+	void PushInteger<unsigned int>(unsigned int count, unsigned int divisor)
+	{
+		m_Elements.push_back({ GL_UNSIGNED_INT, count, GL_FALSE, divisor, true });
 		m_Stride += count * VertexBufferElement::GetSizedOfType(GL_UNSIGNED_INT);
 	}
 
 	template<>
-	void Push<unsigned char>(unsigned int count)
+	void PushInteger<unsigned short>(unsigned int count, unsigned int divisor)
+	{
+		m_Elements.push_back({ GL_UNSIGNED_SHORT, count, GL_FALSE, divisor, true });
+		m_Stride += count * VertexBufferElement::GetSizedOfType(GL_UNSIGNED_SHORT);
+	}
+
+	template<>
+	void PushInteger<unsigned char>(unsigned int count, unsigned int divisor)
 	{
-		m_Elements.push_back({ GL_UNSIGNED_BYTE, count, GL_TRUE });
+		m_Elements.push_back({ GL_UNSIGNED_BYTE, count, GL_FALSE, divisor, true });
 		m_Stride += count * VertexBufferElement::GetSizedOfType(GL_UNSIGNED_BYTE);
 	}
 
-	inline const std::vector<VertexBufferElement> GetElements() const { return m_Elements; }
+	inline const std::vector<VertexBufferElement>& GetElements() const { return m_Elements; }
 	inline unsigned int GetStride() const { return m_Stride; }
+
+	uint32_t GetId() const
+	{
+		uint32_t id = LayoutIdBasis;
+		for (const VertexBufferElement& element : m_Elements)
+			id = HashVertexElement(id, element.type, element.count, element.normalized != 0, element.integer, element.divisor);
+		return id;
+	}
 };
\ No newline at end of file
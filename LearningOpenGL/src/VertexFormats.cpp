@@ -0,0 +1,185 @@
+#include "VertexFormats.h"
+
+#include <cmath>
+#include <cstring>
+
+#include <emmintrin.h>
+
+namespace {
+	// Eight 32 bit lanes holding 0 .. 65535 to eight 16 bit lanes. SSE2 can only pack with signed
+	// saturation, so the values are moved into the signed range and back
+	__m128i PackUnsigned16(__m128i low, __m128i high)
+	{
+		const __m128i bias32 = _mm_set1_epi32(0x8000);
+		const __m128i bias16 = _mm_set1_epi16((short)0x8000);
+		__m128i packed = _mm_packs_epi32(_mm_sub_epi32(low, bias32), _mm_sub_epi32(high, bias32));
+		return _mm_xor_si128(packed, bias16);
+	}
+
+	// Four floats to four halves in the low 16 bits of each lane, rounded to nearest even like F16C does.
+	// Too large values become infinity and NaNs become quiet NaNs
+	__m128i FloatToHalf(__m128 value)
+	{
+		const __m128i infinity32 = _mm_set1_epi32(255 << 23);
+		// the first float too large for a half, and the smallest that is a normal half
+		const __m128i tooLarge = _mm_set1_epi32((127 + 16) << 23);
+		const __m128i minNormal = _mm_set1_epi32(113 << 23);
+		const __m128i denormalMagic = _mm_set1_epi32(((127 - 15) + (23 - 10) + 1) << 23);
+		// (15 - 127) << 23 would shift a negative value, the same bits are built from unsigned ones
+		const __m128i rebias = _mm_set1_epi32((int)(0u - (112u << 23)) + 0xFFF);
+
+		__m128i bits = _mm_castps_si128(value);
+		__m128i sign = _mm_and_si128(bits, _mm_set1_epi32((int)0x80000000));
+		__m128i absolute = _mm_xor_si128(bits, sign);
+
+		__m128i isNaN = _mm_cmpgt_epi32(absolute, infinity32);
+		__m128i special = _mm_or_si128(_mm_set1_epi32(0x7C00), _mm_and_si128(isNaN, _mm_set1_epi32(0x200)));
+
+		// Denormals: adding the magic float shifts the 10 mantissa bits to the bottom, and the
+		// addition itself rounds to nearest even
+		__m128 sum = _mm_add_ps(_mm_castsi128_ps(absolute), _mm_castsi128_ps(denormalMagic));
+		__m128i denormal = _mm_sub_epi32(_mm_castps_si128(sum), denormalMagic);
+
+		// Normals: move the exponent to the half's bias and round, ties go to the even mantissa
+		__m128i odd = _mm_and_si128(_mm_srli_epi32(absolute, 13), _mm_set1_epi32(1));
+		__m128i normal = _mm_srli_epi32(_mm_add_epi32(_mm_add_epi32(absolute, rebias), odd), 13);
+
+		__m128i isDenormal = _mm_cmpgt_epi32(minNormal, absolute);
+		__m128i isFinite = _mm_cmpgt_epi32(tooLarge, absolute);
+		__m128i finite = _mm_or_si128(_mm_and_si128(isDenormal, denormal), _mm_andnot_si128(isDenormal, normal));
+		__m128i half = _mm_or_si128(_mm_and_si128(isFinite, finite), _mm_andnot_si128(isFinite, special));
+		return _mm_or_si128(half, _mm_srli_epi32(sign, 16));
+	}
+
+	__m128 Clamp(__m128 value, float low, float high)
+	{
+		return _mm_min_ps(_mm_max_ps(value, _mm_set1_ps(low)), _mm_set1_ps(high));
+	}
+
+	float Clamp(float value, float low, float high)
+	{
+		return value < low ? low : value > high ? high : value;
+	}
+}
+
+void ConvertToHalf(const float* src, Half* dst, size_t count)
+{
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8)
+	{
+		__m128i low = FloatToHalf(_mm_loadu_ps(src + i));
+		__m128i high = FloatToHalf(_mm_loadu_ps(src + i + 4));
+		_mm_storeu_si128((__m128i*)(dst + i), PackUnsigned16(low, high));
+	}
+
+	// the same conversion for the last values, through a padded register
+	if (i < count)
+	{
+		float rest[8] = {};
+		memcpy(rest, src + i, (count - i) * sizeof(float));
+		Half halves[8];
+		ConvertToHalf(rest, halves, 8);
+		memcpy(dst + i, halves, (count - i) * sizeof(Half));
+	}
+}
+
+void ConvertToSNorm16(const float* src, SNorm16* dst, size_t count)
+{
+	const __m128 scale = _mm_set1_ps(32767.0f);
+
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8)
+	{
+		// _mm_cvtps_epi32 rounds to nearest
+		__m128i low = _mm_cvtps_epi32(_mm_mul_ps(Clamp(_mm_loadu_ps(src + i), -1.0f, 1.0f), scale));
+		__m128i high = _mm_cvtps_epi32(_mm_mul_ps(Clamp(_mm_loadu_ps(src + i + 4), -1.0f, 1.0f), scale));
+		_mm_storeu_si128((__m128i*)(dst + i), _mm_packs_epi32(low, high));
+	}
+
+	for (; i < count; i++)
+		dst[i].Value = (int16_t)std::lrint(Clamp(src[i], -1.0f, 1.0f) * 32767.0f);
+}
+
+void ConvertToUNorm16(const float* src, UNorm16* dst, size_t count)
+{
+	const __m128 scale = _mm_set1_ps(65535.0f);
+
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8)
+	{
+		__m128i low = _mm_cvtps_epi32(_mm_mul_ps(Clamp(_mm_loadu_ps(src + i), 0.0f, 1.0f), scale));
+		__m128i high = _mm_cvtps_epi32(_mm_mul_ps(Clamp(_mm_loadu_ps(src + i + 4), 0.0f, 1.0f), scale));
+		_mm_storeu_si128((__m128i*)(dst + i), PackUnsigned16(low, high));
+	}
+
+	for (; i < count; i++)
+		dst[i].Value = (uint16_t)std::lrint(Clamp(src[i], 0.0f, 1.0f) * 65535.0f);
+}
+
+void ConvertToPackedNormal(const float* src, PackedNormal* dst, size_t vertexCount, unsigned int components)
+{
+	const __m128 scale = _mm_set1_ps(511.0f);
+	const __m128i mask10 = _mm_set1_epi32(0x3FF);
+	const __m128i mask2 = _mm_set1_epi32(0x3);
+
+	// Four vertices at a time with one register per component, so every component is shifted by the same amount
+	size_t i = 0;
+	for (; i + 4 <= vertexCount; i += 4)
+	{
+		const float* v = src + i * components;
+		unsigned int c = components;
+		__m128 x = _mm_setr_ps(v[0], v[c], v[2 * c], v[3 * c]);
+		__m128 y = _mm_setr_ps(v[1], v[c + 1], v[2 * c + 1], v[3 * c + 1]);
+		__m128 z = _mm_setr_ps(v[2], v[c + 2], v[2 * c + 2], v[3 * c + 2]);
+		__m128 w = c == 4 ? _mm_setr_ps(v[3], v[c + 3], v[2 * c + 3], v[3 * c + 3]) : _mm_setzero_ps();
+
+		__m128i xi = _mm_and_si128(_mm_cvtps_epi32(_mm_mul_ps(Clamp(x, -1.0f, 1.0f), scale)), mask10);
+		__m128i yi = _mm_and_si128(_mm_cvtps_epi32(_mm_mul_ps(Clamp(y, -1.0f, 1.0f), scale)), mask10);
+		__m128i zi = _mm_and_si128(_mm_cvtps_epi32(_mm_mul_ps(Clamp(z, -1.0f, 1.0f), scale)), mask10);
+		__m128i wi = _mm_and_si128(_mm_cvtps_epi32(Clamp(w, -1.0f, 1.0f)), mask2);
+
+		__m128i packed = _mm_or_si128(_mm_or_si128(xi, _mm_slli_epi32(yi, 10)),
+			_mm_or_si128(_mm_slli_epi32(zi, 20), _mm_slli_epi32(wi, 30)));
+		_mm_storeu_si128((__m128i*)(dst + i), packed);
+	}
+
+	for (; i < vertexCount; i++)
+	{
+		const float* v = src + i * components;
+		uint32_t x = (uint32_t)std::lrint(Clamp(v[0], -1.0f, 1.0f) * 511.0f) & 0x3FF;
+		uint32_t y = (uint32_t)std::lrint(Clamp(v[1], -1.0f, 1.0f) * 511.0f) & 0x3FF;
+		uint32_t z = (uint32_t)std::lrint(Clamp(v[2], -1.0f, 1.0f) * 511.0f) & 0x3FF;
+		uint32_t w = components == 4 ? (uint32_t)std::lrint(Clamp(v[3], -1.0f, 1.0f)) & 0x3 : 0;
+		dst[i].Bits = x | (y << 10) | (z << 20) | (w << 30);
+	}
+}
+
+float HalfToFloat(Half value)
+{
+	uint32_t sign = (uint32_t)(value.Bits & 0x8000) << 16;
+	uint32_t exponent = (value.Bits >> 10) & 0x1F;
+	uint32_t mantissa = value.Bits & 0x3FF;
+
+	float result;
+	if (exponent == 0)
+	{
+		// zero or denormal: mantissa * 2^-24
+		result = std::ldexp((float)mantissa, -24);
+	}
+	else if (exponent == 31)
+	{
+		uint32_t bits = 0x7F800000 | (mantissa << 13);
+		memcpy(&result, &bits, sizeof(float));
+	}
+	else
+	{
+		uint32_t bits = ((exponent + 112) << 23) | (mantissa << 13);
+		memcpy(&result, &bits, sizeof(float));
+	}
+
+	uint32_t bits;
+	memcpy(&bits, &result, sizeof(float));
+	bits |= sign;
+	memcpy(&result, &bits, sizeof(float));
+	return result;
+}
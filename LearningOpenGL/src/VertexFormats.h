@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Compact storage types for vertex attributes, pushed onto a VertexBufferLayout like float.
+// The shader still reads floats, OpenGL converts them while fetching the vertex.
+
+// IEEE half float (GL_HALF_FLOAT): 11 bits of precision, enough for UVs and local positions
+struct Half
+{
+	uint16_t Bits;
+};
+
+// Signed normalized short (GL_SHORT): -32767 .. 32767 is read as -1 .. 1
+struct SNorm16
+{
+	int16_t Value;
+};
+
+// Unsigned normalized short (GL_UNSIGNED_SHORT): 0 .. 65535 is read as 0 .. 1
+struct UNorm16
+{
+	uint16_t Value;
+};
+
+// Four signed normalized components in 32 bits (GL_INT_2_10_10_10_REV): x, y and z get 10 bits
+// and w the top 2, made for normals and tangents. One PackedNormal is one vec4 attribute
+struct PackedNormal
+{
+	uint32_t Bits;
+};
+
+// Converters from float streams, SSE2 for all but the last few values.
+// count is the number of floats in src and of values written to dst
+void ConvertToHalf(const float* src, Half* dst, size_t count);
+void ConvertToSNorm16(const float* src, SNorm16* dst, size_t count);
+void ConvertToUNorm16(const float* src, UNorm16* dst, size_t count);
+// vertexCount vectors of components (3 or 4) floats each, w is 0 when there are only 3
+void ConvertToPackedNormal(const float* src, PackedNormal* dst, size_t vertexCount, unsigned int components);
+
+// The other way, e.g. to check what precision a format keeps
+float HalfToFloat(Half value);
\ No newline at end of file
@@ -1,7 +1,18 @@
 #include "Test.h"
 #include "imgui/imgui.h"
 
+#include "FramePacket.h"
+#include "RenderThread.h"
+
 namespace test {
+	void Test::OnUpdate(float deltaTime, FramePacket& packet)
+	{
+		OnUpdate(deltaTime);
+
+		// runs while the next update does, see Test.h
+		packet.AddCallback([this]() { OnRender(); });
+	}
+
 	TestMenu::TestMenu(Test*& currentTestPointer)
 		: m_CurrentTest(currentTestPointer)
 	{
@@ -11,8 +22,9 @@ namespace test {
 	{
 		for (auto& test : m_Tests)
 		{
+			// tests create GL objects, so they are made where the context is
 			if (ImGui::Button(test.first.c_str()))
-				m_CurrentTest = test.second();
+				RenderThread::Execute([&]() { m_CurrentTest = test.second(); });
 		}
 	}
 }
\ No newline at end of file
@@ -3,6 +3,8 @@
 #include <vector>
 #include <functional>
 
+class FramePacket;
+
 namespace test {
 
 	class Test
@@ -12,6 +14,13 @@ namespace test {
 		virtual ~Test() {}
 
 		virtual void OnUpdate(float deltaTime) {}
+		// Render thread mode: updates on the main thread and records the frame into packet.
+		// By default OnRender is called from the render thread while the next OnUpdate and
+		// OnImGuiRender already run, so it may only read members those leave alone. Tests
+		// with changing state override this and record copies of it (small values captured
+		// by the callback, larger data in a FrameSnapshot), the few frames that cannot be
+		// drawn from a copy call packet.SetSynchronous().
+		virtual void OnUpdate(float deltaTime, FramePacket& packet);
 		virtual void OnRender() {}
 		virtual void OnImGuiRender() {}
 	};
@@ -0,0 +1,120 @@
+#include "TestBatchRendering.h"
+
+#include "imgui/imgui.h"
+
+#include "glm/glm.hpp"
+#include "glm/gtc/matrix_transform.hpp"
+
+#include <cmath>
+
+namespace test {
+	TestBatchRendering::TestBatchRendering()
+		: m_Camera(960.0f, 540.0f),
+		m_SpriteCount(10000), m_WorldScale(1.0f), m_CameraPosition(0.0f), m_Cull(true),
+		m_SpriteSize(0.0f), m_BuiltCount(0), m_BuiltScale(0.0f), m_LastStats(BatchStats())
+	{
+		// Enable blending of alpha (layers of transparency in textures)
+		GLCall(glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA));
+		GLCall(glEnable(GL_BLEND));
+
+		// Setting up shaders and textures
+		m_Shader = std::make_unique<Shader>("res/shaders/Batch.shader");
+		m_Texture = std::make_unique<Texture>("res/textures/Nu Final.png");
+	}
+
+	TestBatchRendering::~TestBatchRendering()
+	{
+	}
+
+	void TestBatchRendering::BuildSprites()
+	{
+		// Square grid just big enough to hold every sprite
+		int columns = (int)std::ceil(std::sqrt((float)m_SpriteCount));
+		m_SpriteSize = glm::vec2(960.0f, 540.0f) * m_WorldScale / (float)columns;
+
+		m_Positions.resize(m_SpriteCount);
+		m_Bounds.Clear();
+		m_Bounds.Reserve(m_SpriteCount);
+
+		glm::vec3 half(m_SpriteSize * 0.5f, 0.0f);
+		for (int i = 0; i < m_SpriteCount; i++)
+		{
+			m_Positions[i] = glm::vec2((i % columns + 0.5f) * m_SpriteSize.x, (i / columns + 0.5f) * m_SpriteSize.y);
+			glm::vec3 center(m_Positions[i], 0.0f);
+			m_Bounds.Add(center - half, center + half);
+		}
+
+		m_BuiltCount = m_SpriteCount;
+		m_BuiltScale = m_WorldScale;
+	}
+
+	void TestBatchRendering::OnUpdate(float deltaTime)
+	{
+		if (m_SpriteCount != m_BuiltCount || m_WorldScale != m_BuiltScale)
+			BuildSprites();
+
+		m_Camera.SetPosition(m_CameraPosition);
+	}
+
+	void TestBatchRendering::OnUpdate(float deltaTime, FramePacket& packet)
+	{
+		OnUpdate(deltaTime);
+
+		CollectSprites(m_VisiblePositions.Get());
+		glm::vec2 spriteSize = m_SpriteSize;
+		glm::mat4 viewProj = m_Camera.GetViewProjection();
+		m_VisiblePositions.Submit(packet, [this, spriteSize, viewProj](const std::vector<glm::vec2>& positions)
+		{
+			Draw(positions, spriteSize, viewProj);
+		});
+	}
+
+	void TestBatchRendering::OnRender()
+	{
+		std::vector<glm::vec2>& positions = m_VisiblePositions.Get();
+		CollectSprites(positions);
+		Draw(positions, m_SpriteSize, m_Camera.GetViewProjection());
+	}
+
+	void TestBatchRendering::CollectSprites(std::vector<glm::vec2>& positions)
+	{
+		if (m_Cull)
+		{
+			// Only the sprites inside the view volume reach the batch
+			CullBoxes(m_Camera.GetFrustum(), m_Bounds, m_Visible);
+			positions.resize(m_Visible.size());
+			for (size_t i = 0; i < m_Visible.size(); i++)
+				positions[i] = m_Positions[m_Visible[i]];
+		}
+		else
+		{
+			positions = m_Positions;
+		}
+	}
+
+	void TestBatchRendering::Draw(const std::vector<glm::vec2>& positions, const glm::vec2& spriteSize, const glm::mat4& viewProj)
+	{
+		GLCall(glClearColor(0.0f, 0.0f, 0.0f, 1.0f));
+		GLCall(glClear(GL_COLOR_BUFFER_BIT));
+
+		m_Renderer.ResetBatchStats();
+		m_Renderer.BeginBatch(*m_Shader, viewProj);
+		for (const glm::vec2& position : positions)
+			m_Renderer.DrawQuad(position, spriteSize, *m_Texture);
+		m_Renderer.EndBatch();
+
+		m_LastStats.store(m_Renderer.GetBatchStats());
+	}
+
+	void TestBatchRendering::OnImGuiRender()
+	{
+		ImGui::SliderInt("Sprites", &m_SpriteCount, 1, 100000);
+		ImGui::SliderFloat("World size", &m_WorldScale, 1.0f, 10.0f);
+		ImGui::SliderFloat2("Camera", &m_CameraPosition.x, 0.0f, 960.0f * m_WorldScale);
+		ImGui::Checkbox("Frustum culling", &m_Cull);
+		BatchStats stats = m_LastStats.load();
+		ImGui::Text("Draw calls: %u", stats.DrawCalls);
+		ImGui::Text("Quads: %u", stats.QuadCount);
+		ImGui::Text("Application average %.3f ms/frame (%.1f FPS)", 1000.0f / ImGui::GetIO().Framerate, ImGui::GetIO().Framerate);
+	}
+}
\ No newline at end of file
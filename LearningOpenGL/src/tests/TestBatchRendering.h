@@ -0,0 +1,66 @@
+#pragma once
+
+#include "Test.h"
+
+#include "Renderer.h"
+#include "Texture.h"
+#include "Culling.h"
+#include "Camera.h"
+#include "FramePacket.h"
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace test{
+
+	class TestBatchRendering : public Test
+	{
+	public:
+		TestBatchRendering();
+		~TestBatchRendering();
+
+		void OnUpdate(float deltaTime) override;
+		void OnUpdate(float deltaTime, FramePacket& packet) override;
+		void OnRender() override;
+		void OnImGuiRender() override;
+
+	private:
+		// lays the sprites out in a grid and records their bounds for culling
+		void BuildSprites();
+		// fills positions with the sprites that have to be drawn this frame
+		void CollectSprites(std::vector<glm::vec2>& positions);
+		void Draw(const std::vector<glm::vec2>& positions, const glm::vec2& spriteSize, const glm::mat4& viewProj);
+
+		// the renderer keeps its batch buffers alive between frames
+		Renderer m_Renderer;
+
+		std::unique_ptr<Shader> m_Shader;
+		std::unique_ptr<Texture> m_Texture;
+
+		// its frustum is only rebuilt when the camera moves
+		OrthographicCamera m_Camera;
+
+		// number of sprites drawn in a grid across the world
+		int m_SpriteCount;
+		// world size in screens, anything outside the current screen can be culled
+		float m_WorldScale;
+		glm::vec3 m_CameraPosition;
+		bool m_Cull;
+
+		// sprites as they were last built, and their bounds
+		std::vector<glm::vec2> m_Positions;
+		glm::vec2 m_SpriteSize;
+		BoundsSoA m_Bounds;
+		int m_BuiltCount;
+		float m_BuiltScale;
+
+		// indices of the sprites that survived culling this frame
+		std::vector<unsigned int> m_Visible;
+		// their positions, culled on the main thread for the render thread
+		FrameSnapshot<std::vector<glm::vec2>> m_VisiblePositions;
+
+		// what the last frame cost in draw calls, written while drawing
+		std::atomic<BatchStats> m_LastStats;
+	};
+}
\ No newline at end of file
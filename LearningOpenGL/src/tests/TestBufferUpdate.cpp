@@ -0,0 +1,200 @@
+#include "TestBufferUpdate.h"
+
+#include "imgui/imgui.h"
+#include "FramePacket.h"
+
+#include "glm/glm.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstring>
+
+namespace test {
+	static const char* s_StrategyNames[] = { "Reallocate", "SubData", "Orphan", "Unsynchronized map", "Persistent ring" };
+
+	TestBufferUpdate::TestBufferUpdate()
+		: m_Camera(960.0f, 540.0f), m_QuadCount(50000), m_Strategy(SubData), m_Time(0.0f), m_BenchmarkFrame(-1),
+		m_Region(0), m_BenchmarkTotal(0.0f), m_UploadTime(0.0f), m_RingWaits(0)
+	{
+		for (int i = 0; i < StrategyCount; i++)
+			m_Results[i].store(0.0f);
+
+		unsigned int frameSize = MaxQuads * 4 * (unsigned int)sizeof(StreamVertex);
+
+		// Room for three frames, so the unsynchronised map and the ring never write what is being drawn
+		m_VertexBuffer = std::make_unique<VertexBuffer>(3 * frameSize, BufferUsage::Stream);
+		m_Ring = std::make_unique<StreamingBuffer>(3 * frameSize);
+
+		using StreamLayout = StaticLayout<Float2, Float4>;
+		static_assert(StreamLayout::Stride == sizeof(StreamVertex), "StreamLayout does not match StreamVertex");
+
+		m_VAO = std::make_unique<VertexArray>();
+		m_VAO->AddBuffer(*m_VertexBuffer, StreamLayout());
+		m_RingVAO = std::make_unique<VertexArray>();
+		m_RingVAO->AddBuffer(*m_Ring, StreamLayout());
+
+		m_Shader = std::make_unique<Shader>("res/shaders/Stream.shader");
+		m_Vertices.resize(MaxQuads * 4);
+	}
+
+	TestBufferUpdate::~TestBufferUpdate()
+	{
+	}
+
+	int TestBufferUpdate::Upload(Strategy strategy, unsigned int size)
+	{
+		// Reallocate shrinks the buffer to one frame, the other strategies need all three regions back
+		unsigned int capacity = 3 * MaxQuads * 4 * (unsigned int)sizeof(StreamVertex);
+		if (strategy != Reallocate && strategy != PersistentRing && m_VertexBuffer->GetSize() != capacity)
+			m_VertexBuffer->SetData(nullptr, capacity);
+
+		switch (strategy)
+		{
+		case Reallocate:
+			m_VertexBuffer->SetData(m_Vertices.data(), size);
+			return 0;
+		case SubData:
+			m_VertexBuffer->SetSubData(m_Vertices.data(), size, 0, BufferUpdate::SubData);
+			return 0;
+		case Orphan:
+			m_VertexBuffer->SetSubData(m_Vertices.data(), size, 0, BufferUpdate::Orphan);
+			return 0;
+		case UnsynchronizedMap:
+		{
+			// The GPU may still read the other regions, but never the one the last wrap orphaned
+			unsigned int offset = m_Region * (capacity / 3);
+			BufferUpdate update = m_Region == 0 ? BufferUpdate::Orphan : BufferUpdate::UnsynchronizedMap;
+			void* data = m_VertexBuffer->Map(size, offset, update);
+			memcpy(data, m_Vertices.data(), size);
+			m_VertexBuffer->Unmap();
+
+			m_Region = (m_Region + 1) % 3;
+			return (int)(offset / sizeof(StreamVertex));
+		}
+		case PersistentRing:
+		{
+			void* data = m_Ring->Map(size, sizeof(StreamVertex));
+			memcpy(data, m_Vertices.data(), size);
+			return (int)(m_Ring->Unmap() / sizeof(StreamVertex));
+		}
+		default:
+			return 0;
+		}
+	}
+
+	void TestBufferUpdate::OnUpdate(float deltaTime)
+	{
+		m_Time += deltaTime;
+	}
+
+	void TestBufferUpdate::OnUpdate(float deltaTime, FramePacket& packet)
+	{
+		OnUpdate(deltaTime);
+
+		// The sliders and the benchmark change on this thread while the frame is drawn, so it gets a copy
+		Frame frame = NextFrame();
+		packet.AddCallback([this, frame]() { Draw(frame); });
+	}
+
+	void TestBufferUpdate::OnRender()
+	{
+		Draw(NextFrame());
+	}
+
+	TestBufferUpdate::Frame TestBufferUpdate::NextFrame()
+	{
+		// A benchmark switches strategy every BenchmarkFrames frames
+		Frame frame = { (Strategy)m_Strategy, m_QuadCount, m_Time, m_BenchmarkFrame };
+		if (m_BenchmarkFrame >= 0)
+		{
+			frame.UploadStrategy = (Strategy)(m_BenchmarkFrame / BenchmarkFrames);
+
+			m_BenchmarkFrame++;
+			if (m_BenchmarkFrame == StrategyCount * BenchmarkFrames)
+				m_BenchmarkFrame = -1;
+		}
+		return frame;
+	}
+
+	void TestBufferUpdate::Draw(const Frame& frame)
+	{
+		GLCall(glClearColor(0.0f, 0.0f, 0.0f, 1.0f));
+		GLCall(glClear(GL_COLOR_BUFFER_BIT));
+
+		// Every quad moves every frame, so all of the geometry has to be uploaded again
+		int quadCount = frame.QuadCount;
+		int columns = (int)std::ceil(std::sqrt((float)quadCount));
+		glm::vec2 cell(960.0f / columns, 540.0f / columns);
+		for (int i = 0; i < quadCount; i++)
+		{
+			float phase = frame.Time * 2.0f + i * 0.01f;
+			glm::vec2 center((i % columns + 0.5f) * cell.x, (i / columns + 0.5f) * cell.y);
+			glm::vec2 half = cell * (0.3f + 0.15f * std::sin(phase));
+			glm::vec4 color(0.5f + 0.5f * std::sin(phase), 0.5f + 0.5f * std::cos(phase), 1.0f, 1.0f);
+
+			StreamVertex* quad = &m_Vertices[i * 4];
+			quad[0] = { center + glm::vec2(-half.x, -half.y), color };
+			quad[1] = { center + glm::vec2( half.x, -half.y), color };
+			quad[2] = { center + glm::vec2( half.x,  half.y), color };
+			quad[3] = { center + glm::vec2(-half.x,  half.y), color };
+		}
+
+		// Only the upload is timed, a stalling strategy shows up here as CPU time
+		Strategy strategy = frame.UploadStrategy;
+		unsigned int size = quadCount * 4 * (unsigned int)sizeof(StreamVertex);
+		auto start = std::chrono::high_resolution_clock::now();
+		int baseVertex = Upload(strategy, size);
+		auto end = std::chrono::high_resolution_clock::now();
+		float uploadTime = std::chrono::duration<float, std::milli>(end - start).count();
+		float averageTime = m_UploadTime.load();
+		m_UploadTime.store(averageTime + (uploadTime - averageTime) * 0.1f);
+
+		m_Shader->Bind();
+		m_Shader->SetUniformMat4f("u_ViewProj", m_Camera.GetViewProjection());
+		if (strategy == PersistentRing)
+			m_RingVAO->Bind();
+		else
+			m_VAO->Bind();
+		const IndexBuffer& indices = QuadIndexBuffer::Get(quadCount);
+		indices.Bind();
+		GLCall(glDrawElementsBaseVertex(GL_TRIANGLES, quadCount * 6, indices.GetType(), nullptr, baseVertex));
+
+		if (strategy == PersistentRing)
+			m_Ring->Fence();
+		m_RingWaits.store(m_Ring->GetWaitCount());
+
+		if (frame.BenchmarkFrame >= 0)
+		{
+			int benchmarkFrame = frame.BenchmarkFrame % BenchmarkFrames;
+			if (benchmarkFrame == 0)
+				m_BenchmarkTotal = 0.0f;
+			if (benchmarkFrame >= WarmupFrames)
+				m_BenchmarkTotal += uploadTime;
+			if (benchmarkFrame == BenchmarkFrames - 1)
+				m_Results[strategy].store(m_BenchmarkTotal / (BenchmarkFrames - WarmupFrames));
+		}
+	}
+
+	void TestBufferUpdate::OnImGuiRender()
+	{
+		ImGui::SliderInt("Quads", &m_QuadCount, 1, MaxQuads);
+		ImGui::Combo("Strategy", &m_Strategy, s_StrategyNames, StrategyCount);
+		ImGui::Text("%.2f MB per frame, upload %.3f ms", m_QuadCount * 4 * sizeof(StreamVertex) / (1024.0f * 1024.0f), m_UploadTime.load());
+		if (!m_Ring->IsPersistent())
+			ImGui::Text("No glBufferStorage, the ring maps with glMapBufferRange");
+
+		if (m_BenchmarkFrame >= 0)
+		{
+			ImGui::Text("Benchmarking %s...", s_StrategyNames[m_BenchmarkFrame / BenchmarkFrames]);
+		}
+		else if (ImGui::Button("Benchmark all strategies"))
+		{
+			m_BenchmarkFrame = 0;
+		}
+
+		for (int i = 0; i < StrategyCount; i++)
+			ImGui::Text("%-20s %.3f ms", s_StrategyNames[i], m_Results[i].load());
+		ImGui::Text("Ring waits for the GPU: %u", m_RingWaits.load());
+		ImGui::Text("Application average %.3f ms/frame (%.1f FPS)", 1000.0f / ImGui::GetIO().Framerate, ImGui::GetIO().Framerate);
+	}
+}
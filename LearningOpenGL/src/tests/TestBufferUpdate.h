@@ -0,0 +1,97 @@
+#pragma once
+
+#include "Test.h"
+
+#include "Renderer.h"
+#include "VertexBuffer.h"
+#include "StaticLayout.h"
+#include "StreamingBuffer.h"
+#include "QuadIndexBuffer.h"
+#include "Camera.h"
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace test{
+
+	// Rewrites a large vertex buffer every frame with each update strategy and times the upload
+	class TestBufferUpdate : public Test
+	{
+	public:
+		TestBufferUpdate();
+		~TestBufferUpdate();
+
+		void OnUpdate(float deltaTime) override;
+		void OnUpdate(float deltaTime, FramePacket& packet) override;
+		void OnRender() override;
+		void OnImGuiRender() override;
+
+	private:
+		struct StreamVertex
+		{
+			glm::vec2 Position;
+			glm::vec4 Color;
+		};
+
+		enum Strategy
+		{
+			// glBufferData with the new contents, what recreating the buffer every frame costs
+			Reallocate,
+			SubData,
+			Orphan,
+			// three regions written in turn, orphaning when wrapping back to the first
+			UnsynchronizedMap,
+			// the fenced, persistently mapped ring of StreamingBuffer
+			PersistentRing,
+			StrategyCount
+		};
+
+		// what one frame draws, decided on the main thread and copied to the render thread
+		struct Frame
+		{
+			Strategy UploadStrategy;
+			int QuadCount;
+			float Time;
+			// frame of the running benchmark, -1 when none
+			int BenchmarkFrame;
+		};
+
+		static const int MaxQuads = 100000;
+		// frames each strategy runs for during a benchmark, the first few are not timed
+		static const int BenchmarkFrames = 120;
+		static const int WarmupFrames = 10;
+
+		// writes the vertices of this frame and returns the vertex they start at in the buffer
+		int Upload(Strategy strategy, unsigned int size);
+		// picks this frame's strategy and moves the benchmark along
+		Frame NextFrame();
+		void Draw(const Frame& frame);
+
+		std::unique_ptr<VertexBuffer> m_VertexBuffer;
+		std::unique_ptr<StreamingBuffer> m_Ring;
+		std::unique_ptr<VertexArray> m_VAO;
+		std::unique_ptr<VertexArray> m_RingVAO;
+		std::unique_ptr<Shader> m_Shader;
+
+		OrthographicCamera m_Camera;
+
+		int m_QuadCount;
+		int m_Strategy;
+		float m_Time;
+		// a benchmark runs every strategy in turn, m_BenchmarkFrame < 0 when none is running
+		int m_BenchmarkFrame;
+
+		// Only touched by whichever thread draws
+		std::vector<StreamVertex> m_Vertices;
+		// the region the next unsynchronised map writes to
+		unsigned int m_Region;
+		float m_BenchmarkTotal;
+
+		// Written while drawing, read by OnImGuiRender
+		// CPU time of the last uploads, averaged over a few frames
+		std::atomic<float> m_UploadTime;
+		std::atomic<float> m_Results[StrategyCount];
+		std::atomic<unsigned int> m_RingWaits;
+	};
+}
\ No newline at end of file
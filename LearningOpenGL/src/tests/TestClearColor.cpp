@@ -2,6 +2,7 @@
 
 #include "Renderer.h"
 #include "imgui/imgui.h"
+#include "FramePacket.h"
 
 namespace test {
 	TestClearColor::TestClearColor()
@@ -17,6 +18,12 @@ namespace test {
 	{
 	}
 	
+	void TestClearColor::OnUpdate(float deltaTime, FramePacket& packet)
+	{
+		// the render thread clears with the packet color, nothing else is drawn
+		packet.SetClearColor(glm::vec4(m_ClearColor[0], m_ClearColor[1], m_ClearColor[2], m_ClearColor[3]));
+	}
+	
 	void TestClearColor::OnRender()
 	{
 		GLCall(glClearColor(m_ClearColor[0], m_ClearColor[1], m_ClearColor[2], m_ClearColor[3]));
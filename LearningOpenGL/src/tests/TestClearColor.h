@@ -11,6 +11,7 @@ namespace test{
 		~TestClearColor();
 
 		void OnUpdate(float deltaTime) override;
+		void OnUpdate(float deltaTime, FramePacket& packet) override;
 		void OnRender() override;
 		void OnImGuiRender() override;
 
@@ -0,0 +1,114 @@
+#include "TestDrawIndirect.h"
+
+#include "imgui/imgui.h"
+#include "FramePacket.h"
+
+#include "glm/glm.hpp"
+#include "glm/gtc/matrix_transform.hpp"
+
+#include <cmath>
+
+namespace test {
+	TestDrawIndirect::TestDrawIndirect()
+		: m_Proj(glm::ortho(0.0f, 960.0f, 0.0f, 540.0f, -1.0f, 1.0f)),
+		m_View(glm::translate(glm::mat4(1.0f), glm::vec3(0, 0, 0))),
+		m_DrawCount(1000)
+	{
+		// Three different meshes packed into one vertex buffer (x, y)
+		float positions[] = {
+			// square
+			-1.0f, -1.0f,
+			 1.0f, -1.0f,
+			 1.0f,  1.0f,
+			-1.0f,  1.0f,
+			// triangle
+			-1.0f, -1.0f,
+			 1.0f, -1.0f,
+			 0.0f,  1.0f,
+			// diamond
+			 0.0f, -1.0f,
+			 1.0f,  0.0f,
+			 0.0f,  1.0f,
+			-1.0f,  0.0f,
+		};
+
+		// Indices are relative to each mesh, the base vertex moves them to the right place
+		unsigned int indices[] = {
+			0, 1, 2, 2, 3, 0,
+			0, 1, 2,
+			0, 1, 2, 2, 3, 0,
+		};
+
+		m_Meshes[0] = { 6, 0, 0 };
+		m_Meshes[1] = { 3, 6, 4 };
+		m_Meshes[2] = { 6, 9, 7 };
+
+		m_VertexBuffer = std::make_unique<VertexBuffer>(positions, 11 * 2 * sizeof(float));
+		m_IndexBuffer = std::make_unique<IndexBuffer>(indices, 15);
+
+		VertexBufferLayout layout;
+		layout.Push<float>(2);
+
+		m_VAO = std::make_unique<VertexArray>();
+		m_VAO->AddBuffer(*m_VertexBuffer, layout);
+
+		// the draw ID attribute lands at location 1
+		m_Draws = std::make_unique<DrawIndirectBuffer>(MaxDraws);
+		m_Draws->AttachDrawID(*m_VAO);
+
+		m_Shader = std::make_unique<Shader>("res/shaders/Indirect.shader");
+	}
+
+	TestDrawIndirect::~TestDrawIndirect()
+	{
+	}
+
+	void TestDrawIndirect::OnUpdate(float deltaTime)
+	{
+	}
+
+	void TestDrawIndirect::OnUpdate(float deltaTime, FramePacket& packet)
+	{
+		// the slider may move again before the render thread gets to this frame
+		int drawCount = m_DrawCount;
+		packet.AddCallback([this, drawCount]() { Draw(drawCount); });
+	}
+
+	void TestDrawIndirect::OnRender()
+	{
+		Draw(m_DrawCount);
+	}
+
+	void TestDrawIndirect::Draw(int drawCount)
+	{
+		// Rebuild the command list and upload it in one go, with the context the render thread may own
+		m_Draws->Clear();
+		for (int i = 0; i < drawCount; i++)
+		{
+			const MeshRange& mesh = m_Meshes[i % 3];
+			m_Draws->AddDraw(mesh.IndexCount, mesh.FirstIndex, mesh.BaseVertex);
+		}
+		m_Draws->Upload();
+
+		GLCall(glClearColor(0.0f, 0.0f, 0.0f, 1.0f));
+		GLCall(glClear(GL_COLOR_BUFFER_BIT));
+
+		int columns = (int)std::ceil(std::sqrt((float)drawCount * 960.0f / 540.0f));
+
+		m_Shader->Bind();
+		m_Shader->SetUniformMat4f("u_ViewProj", m_Proj * m_View);
+		m_Shader->SetUniform1i("u_Columns", columns);
+		m_Shader->SetUniform1f("u_CellSize", 960.0f / columns);
+
+		Renderer renderer;
+		renderer.DrawIndirect(*m_VAO, *m_IndexBuffer, *m_Shader, *m_Draws);
+	}
+
+	void TestDrawIndirect::OnImGuiRender()
+	{
+		ImGui::SliderInt("Draws", &m_DrawCount, 1, MaxDraws);
+		ImGui::Text("Path: %s", DrawIndirectBuffer::IsMultiDrawSupported() ?
+			"glMultiDrawElementsIndirect" : "glDrawElementsBaseVertex loop");
+		ImGui::Text("Application average %.3f ms/frame (%.1f FPS)", 1000.0f / ImGui::GetIO().Framerate, ImGui::GetIO().Framerate);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "Test.h"
+
+#include "Renderer.h"
+#include "VertexBuffer.h"
+#include "VertexBufferLayout.h"
+#include "DrawIndirectBuffer.h"
+
+#include <memory>
+
+namespace test{
+
+	class TestDrawIndirect : public Test
+	{
+	public:
+		TestDrawIndirect();
+		~TestDrawIndirect();
+
+		void OnUpdate(float deltaTime) override;
+		void OnUpdate(float deltaTime, FramePacket& packet) override;
+		void OnRender() override;
+		void OnImGuiRender() override;
+
+	private:
+		// where one mesh lives inside the shared vertex and index buffers
+		struct MeshRange
+		{
+			unsigned int IndexCount;
+			unsigned int FirstIndex;
+			int BaseVertex;
+		};
+
+		static const int MaxDraws = 20000;
+
+		void Draw(int drawCount);
+
+		std::unique_ptr<VertexArray> m_VAO;
+		std::unique_ptr<VertexBuffer> m_VertexBuffer;
+		std::unique_ptr<IndexBuffer> m_IndexBuffer;
+		std::unique_ptr<DrawIndirectBuffer> m_Draws;
+		std::unique_ptr<Shader> m_Shader;
+
+		MeshRange m_Meshes[3];
+
+		glm::mat4 m_Proj;
+		glm::mat4 m_View;
+
+		int m_DrawCount;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,148 @@
+#include "TestGPUCulling.h"
+
+#include "imgui/imgui.h"
+#include "FramePacket.h"
+
+#include "glm/glm.hpp"
+#include "glm/gtc/matrix_transform.hpp"
+
+#include <random>
+#include <vector>
+
+namespace test {
+	TestGPUCulling::TestGPUCulling()
+		: m_Supported(GPUCuller::IsSupported()), m_Camera(960.0f, 540.0f), m_CameraPosition(0.0f),
+		m_InstanceCount(50000), m_BuiltCount(0), m_WorldScale(4.0f), m_ShowVisible(false), m_VisibleCount(0)
+	{
+		if (!m_Supported)
+			return;
+
+		// Enable blending of alpha (layers of transparency in textures)
+		GLCall(glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA));
+		GLCall(glEnable(GL_BLEND));
+
+		// A unit square with texture coordinates (x, y, normal_x, normal_y), scaled per instance
+		float positions[] = {
+			-0.5f, -0.5f, 0.0f, 0.0f,
+			 0.5f, -0.5f, 1.0f, 0.0f,
+			 0.5f,  0.5f, 1.0f, 1.0f,
+			-0.5f,  0.5f, 0.0f, 1.0f,
+		};
+		unsigned int indices[] = {
+			0, 1, 2,
+			2, 3, 0
+		};
+
+		VertexBufferLayout layout;
+		layout.Push<float>(2);
+		layout.Push<float>(2);
+
+		m_VertexBuffer = std::make_unique<VertexBuffer>(positions, 4 * 4 * sizeof(float));
+		m_IndexBuffer = std::make_unique<IndexBuffer>(indices, 6);
+		m_VAO = std::make_unique<VertexArray>();
+		m_VAO->AddBuffer(*m_VertexBuffer, layout);
+
+		m_Shader = std::make_unique<Shader>("res/shaders/Culled.shader");
+		m_Shader->Bind();
+		m_Shader->SetUniform1i("u_Texture", 0);
+		m_Texture = std::make_unique<Texture>("res/textures/Nu Final.png");
+
+		m_CameraBuffer = std::make_unique<UniformBuffer>(sizeof(CameraUniforms), UniformBuffer::CameraBinding);
+		m_Instances = std::make_unique<ShaderStorageBuffer>(nullptr, MaxInstances * sizeof(glm::mat4));
+		m_Culler = std::make_unique<GPUCuller>(MaxInstances);
+	}
+
+	TestGPUCulling::~TestGPUCulling()
+	{
+	}
+
+	void TestGPUCulling::BuildInstances(int instanceCount)
+	{
+		std::mt19937 random(1);
+		std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+		glm::vec2 world = glm::vec2(960.0f, 540.0f) * m_WorldScale;
+
+		std::vector<glm::mat4> models(instanceCount);
+		BoundsSoA bounds;
+		bounds.Reserve(instanceCount);
+		for (int i = 0; i < instanceCount; i++)
+		{
+			glm::vec3 center(unit(random) * world.x, unit(random) * world.y, 0.0f);
+			float size = 8.0f + 16.0f * unit(random);
+
+			models[i] = glm::scale(glm::translate(glm::mat4(1.0f), center), glm::vec3(size, size, 1.0f));
+			glm::vec3 half(size * 0.5f, size * 0.5f, 0.0f);
+			bounds.Add(center - half, center + half);
+		}
+
+		// Only uploaded when the instances change, culling itself never leaves the GPU
+		m_Instances->SetSubData(models.data(), (unsigned int)(models.size() * sizeof(glm::mat4)));
+		m_Culler->SetBounds(bounds);
+		m_BuiltCount.store(instanceCount);
+	}
+
+	void TestGPUCulling::OnUpdate(float deltaTime)
+	{
+		if (!m_Supported)
+			return;
+
+		m_Camera.SetPosition(m_CameraPosition);
+	}
+
+	void TestGPUCulling::OnUpdate(float deltaTime, FramePacket& packet)
+	{
+		OnUpdate(deltaTime);
+
+		// The sliders and the camera may change again before the render thread gets to this frame
+		int instanceCount = m_InstanceCount;
+		m_Camera.Refresh();
+		OrthographicCamera camera = m_Camera;
+		bool readVisible = m_ShowVisible;
+		packet.AddCallback([this, instanceCount, camera, readVisible]() { Draw(instanceCount, camera, readVisible); });
+	}
+
+	void TestGPUCulling::OnRender()
+	{
+		Draw(m_InstanceCount, m_Camera, m_ShowVisible);
+	}
+
+	void TestGPUCulling::Draw(int instanceCount, const OrthographicCamera& camera, bool readVisible)
+	{
+		GLCall(glClearColor(0.0f, 0.0f, 0.0f, 1.0f));
+		GLCall(glClear(GL_COLOR_BUFFER_BIT));
+
+		if (!m_Supported)
+			return;
+
+		// Uploads need the context, which the render thread may own during OnUpdate
+		if (instanceCount != m_BuiltCount.load())
+			BuildInstances(instanceCount);
+
+		m_Renderer.SetCamera(camera, *m_CameraBuffer);
+		m_Culler->Cull(camera.GetFrustum(), m_IndexBuffer->GetCount());
+
+		m_Texture->Bind();
+		m_Instances->BindBase(GPUCuller::InstanceBinding);
+		m_Renderer.DrawCulled(*m_VAO, *m_IndexBuffer, *m_Shader, *m_Culler);
+
+		if (readVisible)
+			m_VisibleCount.store(m_Culler->ReadVisibleCount());
+	}
+
+	void TestGPUCulling::OnImGuiRender()
+	{
+		if (!m_Supported)
+		{
+			ImGui::Text("GPU culling needs OpenGL 4.3 (compute shaders)");
+			return;
+		}
+
+		ImGui::SliderInt("Instances", &m_InstanceCount, 1, MaxInstances);
+		ImGui::SliderFloat2("Camera", &m_CameraPosition.x, 0.0f, 960.0f * m_WorldScale);
+		// reading the count back waits for the GPU, so it is off by default
+		ImGui::Checkbox("Read back visible count", &m_ShowVisible);
+		if (m_ShowVisible)
+			ImGui::Text("Visible: %u of %d", m_VisibleCount.load(), m_BuiltCount.load());
+		ImGui::Text("Application average %.3f ms/frame (%.1f FPS)", 1000.0f / ImGui::GetIO().Framerate, ImGui::GetIO().Framerate);
+	}
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "Test.h"
+
+#include "Renderer.h"
+#include "VertexBuffer.h"
+#include "VertexBufferLayout.h"
+#include "Texture.h"
+#include "Camera.h"
+#include "UniformBuffer.h"
+#include "ShaderStorageBuffer.h"
+#include "GPUCuller.h"
+
+#include <atomic>
+#include <memory>
+
+namespace test{
+
+	class TestGPUCulling : public Test
+	{
+	public:
+		TestGPUCulling();
+		~TestGPUCulling();
+
+		void OnUpdate(float deltaTime) override;
+		void OnUpdate(float deltaTime, FramePacket& packet) override;
+		void OnRender() override;
+		void OnImGuiRender() override;
+
+	private:
+		static const unsigned int MaxInstances = 200000;
+
+		// scatters the instances over the world and uploads their matrices and bounds
+		void BuildInstances(int instanceCount);
+		void Draw(int instanceCount, const OrthographicCamera& camera, bool readVisible);
+
+		Renderer m_Renderer;
+
+		// nothing is created without GL 4.3
+		bool m_Supported;
+
+		std::unique_ptr<VertexArray> m_VAO;
+		std::unique_ptr<VertexBuffer> m_VertexBuffer;
+		std::unique_ptr<IndexBuffer> m_IndexBuffer;
+		std::unique_ptr<Shader> m_Shader;
+		std::unique_ptr<Texture> m_Texture;
+		std::unique_ptr<UniformBuffer> m_CameraBuffer;
+		// model matrix of every instance, read by res/shaders/Culled.shader
+		std::unique_ptr<ShaderStorageBuffer> m_Instances;
+		std::unique_ptr<GPUCuller> m_Culler;
+
+		OrthographicCamera m_Camera;
+		glm::vec3 m_CameraPosition;
+
+		int m_InstanceCount;
+		// written while drawing, shown by ImGui
+		std::atomic<int> m_BuiltCount;
+		// world size in screens
+		float m_WorldScale;
+
+		bool m_ShowVisible;
+		std::atomic<unsigned int> m_VisibleCount;
+	};
+}
\ No newline at end of file
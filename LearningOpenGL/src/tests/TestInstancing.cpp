@@ -0,0 +1,126 @@
+#include "TestInstancing.h"
+
+#include "imgui/imgui.h"
+#include "FramePacket.h"
+
+#include "glm/glm.hpp"
+#include "glm/gtc/matrix_transform.hpp"
+
+#include <cmath>
+#include <vector>
+
+namespace test {
+	TestInstancing::TestInstancing()
+		: m_Proj(glm::ortho(0.0f, 960.0f, 0.0f, 540.0f, -1.0f, 1.0f)),
+		m_View(glm::translate(glm::mat4(1.0f), glm::vec3(0, 0, 0))),
+		m_InstanceCount(10000), m_UploadedCount(0)
+	{
+		// Enable blending of alpha (layers of transparency in textures)
+		GLCall(glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA));
+		GLCall(glEnable(GL_BLEND));
+
+		// Unit square with texture coordinates, the model matrix gives it size and position
+		float positions[] = {
+			-0.5f, -0.5f, 0.0f, 0.0f,
+			 0.5f, -0.5f, 1.0f, 0.0f,
+			 0.5f,  0.5f, 1.0f, 1.0f,
+			-0.5f,  0.5f, 0.0f, 1.0f,
+		};
+
+		unsigned int indices[] = {
+			0, 1, 2,
+			2, 3, 0
+		};
+
+		m_VertexBuffer = std::make_unique<VertexBuffer>(positions, 4 * 4 * sizeof(float));
+		m_IndexBuffer = std::make_unique<IndexBuffer>(indices, 6);
+
+		// Per-instance buffer, big enough for the slider maximum
+		m_InstanceBuffer = std::make_unique<VertexBuffer>(MaxInstances * (unsigned int)sizeof(InstanceData));
+
+		VertexBufferLayout layout;
+		layout.Push<float>(2);
+		layout.Push<float>(2);
+
+		// a mat4 attribute takes four vec4 attributes, then the texture rectangle
+		VertexBufferLayout instanceLayout;
+		for (int column = 0; column < 4; column++)
+			instanceLayout.Push<float>(4, 1);
+		instanceLayout.Push<float>(4, 1);
+
+		// quad attributes go to 0 and 1, instance attributes follow from 2
+		m_VAO = std::make_unique<VertexArray>();
+		m_VAO->AddBuffer(*m_VertexBuffer, layout);
+		m_VAO->AddBuffer(*m_InstanceBuffer, instanceLayout);
+
+		m_Shader = std::make_unique<Shader>("res/shaders/Instanced.shader");
+		m_Shader->Bind();
+		m_Shader->SetUniform1i("u_Texture", 0);
+
+		m_Texture = std::make_unique<Texture>("res/textures/Nu Final.png");
+	}
+
+	TestInstancing::~TestInstancing()
+	{
+	}
+
+	void TestInstancing::UpdateInstances(int instanceCount)
+	{
+		int columns = (int)std::ceil(std::sqrt((float)instanceCount));
+		glm::vec2 size(960.0f / columns, 540.0f / columns);
+
+		std::vector<InstanceData> instances(instanceCount);
+		for (int i = 0; i < instanceCount; i++)
+		{
+			glm::vec3 translation((i % columns + 0.5f) * size.x, (i / columns + 0.5f) * size.y, 0.0f);
+			instances[i].Model = glm::scale(glm::translate(glm::mat4(1.0f), translation), glm::vec3(size, 1.0f));
+
+			// every other instance only shows the lower left quarter of the texture
+			instances[i].TexRect = (i % 2) ? glm::vec4(0.0f, 0.0f, 0.5f, 0.5f) : glm::vec4(0.0f, 0.0f, 1.0f, 1.0f);
+		}
+
+		m_InstanceBuffer->SetSubData(instances.data(), instanceCount * (unsigned int)sizeof(InstanceData));
+		m_UploadedCount = instanceCount;
+	}
+
+	void TestInstancing::OnUpdate(float deltaTime)
+	{
+	}
+
+	void TestInstancing::OnUpdate(float deltaTime, FramePacket& packet)
+	{
+		// the slider may move again before the render thread gets to this frame
+		int instanceCount = m_InstanceCount;
+		packet.AddCallback([this, instanceCount]() { Draw(instanceCount); });
+	}
+
+	void TestInstancing::OnRender()
+	{
+		Draw(m_InstanceCount);
+	}
+
+	void TestInstancing::Draw(int instanceCount)
+	{
+		// Uploads need the context, which the render thread may own during OnUpdate
+		if (instanceCount != m_UploadedCount)
+			UpdateInstances(instanceCount);
+
+		GLCall(glClearColor(0.0f, 0.0f, 0.0f, 1.0f));
+		GLCall(glClear(GL_COLOR_BUFFER_BIT));
+
+		Renderer renderer;
+
+		m_Texture->Bind();
+		m_Shader->Bind();
+		m_Shader->SetUniformMat4f("u_ViewProj", m_Proj * m_View);
+
+		// every instance in a single draw call
+		renderer.DrawInstanced(*m_VAO, *m_IndexBuffer, *m_Shader, m_UploadedCount);
+	}
+
+	void TestInstancing::OnImGuiRender()
+	{
+		ImGui::SliderInt("Instances", &m_InstanceCount, 1, MaxInstances);
+		ImGui::Text("Application average %.3f ms/frame (%.1f FPS)", 1000.0f / ImGui::GetIO().Framerate, ImGui::GetIO().Framerate);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "Test.h"
+
+#include "Renderer.h"
+#include "VertexBuffer.h"
+#include "VertexBufferLayout.h"
+#include "Texture.h"
+
+#include <memory>
+
+namespace test{
+
+	class TestInstancing : public Test
+	{
+	public:
+		TestInstancing();
+		~TestInstancing();
+
+		void OnUpdate(float deltaTime) override;
+		void OnUpdate(float deltaTime, FramePacket& packet) override;
+		void OnRender() override;
+		void OnImGuiRender() override;
+
+	private:
+		// what one instance adds on top of the shared quad
+		struct InstanceData
+		{
+			glm::mat4 Model;
+			glm::vec4 TexRect;
+		};
+
+		static const int MaxInstances = 100000;
+
+		// rebuilds the per-instance buffer when the count changes
+		void UpdateInstances(int instanceCount);
+		void Draw(int instanceCount);
+
+		std::unique_ptr<VertexArray> m_VAO;
+		std::unique_ptr<VertexBuffer> m_VertexBuffer;
+		std::unique_ptr<VertexBuffer> m_InstanceBuffer;
+		std::unique_ptr<IndexBuffer> m_IndexBuffer;
+		std::unique_ptr<Shader> m_Shader;
+		std::unique_ptr<Texture> m_Texture;
+
+		glm::mat4 m_Proj;
+		glm::mat4 m_View;
+
+		int m_InstanceCount;
+		// only touched while drawing
+		int m_UploadedCount;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,236 @@
+#include "TestMeshOptimizer.h"
+
+#include "StaticLayout.h"
+
+#include "imgui/imgui.h"
+#include "FramePacket.h"
+
+#include "glm/glm.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <thread>
+
+namespace test {
+	// same layout as res/shaders/Stream.shader reads
+	struct MeshVertex
+	{
+		glm::vec2 Position;
+		glm::vec4 Color;
+	};
+
+	struct CompressedMeshVertex
+	{
+		Half Position[2];
+		UNorm16 Color[4];
+	};
+
+	TestMeshOptimizer::TestMeshOptimizer()
+		: m_Camera(960.0f, 540.0f), m_Resolution(200), m_BuiltResolution(0),
+		m_Threads((int)std::thread::hardware_concurrency()), m_OptimizeTime(0.0f), m_DrawOptimized(true),
+		m_Compressed(false), m_BuiltCompressed(false)
+	{
+		m_Shader = std::make_unique<Shader>("res/shaders/Stream.shader");
+		if (m_Threads < 1)
+			m_Threads = 1;
+
+		// only the formats live in the vertex arrays, the buffers are attached when drawing
+		m_VAO = std::make_unique<VertexArray>();
+		m_VAO->AddFormat(StaticLayout<Float2, Float4>());
+		m_CompressedVAO = std::make_unique<VertexArray>();
+		m_CompressedVAO->AddFormat(StaticLayout<Half2, UShort4N>());
+
+		BuildMeshes(m_Resolution, m_Compressed, m_Threads);
+		m_BuiltResolution = m_Resolution;
+		m_BuiltCompressed = m_Compressed;
+	}
+
+	TestMeshOptimizer::~TestMeshOptimizer()
+	{
+	}
+
+	TestMeshOptimizer::Mesh TestMeshOptimizer::Upload(const MeshSource& source, bool compressed)
+	{
+		Mesh mesh;
+		if (compressed)
+		{
+			// The converters read plain float streams, so positions and colors are split out first
+			unsigned int count = source.GetVertexCount();
+			const MeshVertex* vertices = (const MeshVertex*)source.Vertices.data();
+			std::vector<glm::vec2> positions(count);
+			std::vector<glm::vec4> colors(count);
+			for (unsigned int i = 0; i < count; i++)
+			{
+				positions[i] = vertices[i].Position;
+				colors[i] = vertices[i].Color;
+			}
+
+			std::vector<Half> halfPositions(count * 2);
+			std::vector<UNorm16> shortColors(count * 4);
+			ConvertToHalf(&positions[0].x, halfPositions.data(), count * 2);
+			ConvertToUNorm16(&colors[0].x, shortColors.data(), count * 4);
+
+			std::vector<CompressedMeshVertex> packed(count);
+			for (unsigned int i = 0; i < count; i++)
+			{
+				memcpy(packed[i].Position, &halfPositions[i * 2], sizeof(packed[i].Position));
+				memcpy(packed[i].Color, &shortColors[i * 4], sizeof(packed[i].Color));
+			}
+
+			mesh.VBO = std::make_unique<VertexBuffer>(packed.data(), count * (unsigned int)sizeof(CompressedMeshVertex));
+		}
+		else
+		{
+			mesh.VBO = std::make_unique<VertexBuffer>(source.Vertices.data(), (unsigned int)source.Vertices.size());
+		}
+		mesh.IBO = std::make_unique<IndexBuffer>(source.Indices.data(), (unsigned int)source.Indices.size());
+		return mesh;
+	}
+
+	void TestMeshOptimizer::BuildMeshes(int resolution, bool compressed, int threads)
+	{
+		// Every mesh covers one cell of a 4 x 2 grid over the screen
+		std::vector<MeshSource> sources(MeshCount);
+		std::mt19937 random(1);
+		int side = resolution + 1;
+		glm::vec2 cell(960.0f / 4, 540.0f / 2);
+
+		for (int m = 0; m < MeshCount; m++)
+		{
+			MeshSource& source = sources[m];
+			source.VertexSize = sizeof(MeshVertex);
+
+			// vertices are stored in a random order, as if no exporter ever cared
+			std::vector<unsigned int> order(side * side);
+			for (unsigned int i = 0; i < order.size(); i++)
+				order[i] = i;
+			std::shuffle(order.begin(), order.end(), random);
+
+			source.Vertices.resize(order.size() * sizeof(MeshVertex));
+			MeshVertex* vertices = (MeshVertex*)source.Vertices.data();
+			glm::vec2 origin((m % 4) * cell.x, (m / 4) * cell.y);
+			for (int y = 0; y < side; y++)
+			{
+				for (int x = 0; x < side; x++)
+				{
+					glm::vec2 uv(x / (float)resolution, y / (float)resolution);
+					float wave = 0.5f + 0.5f * std::sin((uv.x + uv.y) * 12.0f + m);
+					vertices[order[y * side + x]] = { origin + uv * cell * 0.95f, glm::vec4(uv, wave, 1.0f) };
+				}
+			}
+
+			// and so are the triangles
+			std::vector<std::array<unsigned int, 3>> triangles;
+			triangles.reserve(resolution * resolution * 2);
+			for (int y = 0; y < resolution; y++)
+			{
+				for (int x = 0; x < resolution; x++)
+				{
+					unsigned int a = order[y * side + x], b = order[y * side + x + 1];
+					unsigned int c = order[(y + 1) * side + x + 1], d = order[(y + 1) * side + x];
+					triangles.push_back({ a, b, c });
+					triangles.push_back({ c, d, a });
+				}
+			}
+			std::shuffle(triangles.begin(), triangles.end(), random);
+
+			source.Indices.resize(triangles.size() * 3);
+			memcpy(source.Indices.data(), triangles.data(), source.Indices.size() * sizeof(unsigned int));
+		}
+
+		m_Original.clear();
+		for (const MeshSource& source : sources)
+			m_Original.push_back(Upload(source, compressed));
+
+		// The optimiser works on the sources in place, right before the buffers are created
+		auto start = std::chrono::high_resolution_clock::now();
+		m_Stats = MeshOptimizer::Optimize(sources, threads);
+		auto end = std::chrono::high_resolution_clock::now();
+		m_OptimizeTime = std::chrono::duration<float, std::milli>(end - start).count();
+
+		m_Optimized.clear();
+		for (const MeshSource& source : sources)
+			m_Optimized.push_back(Upload(source, compressed));
+	}
+
+	void TestMeshOptimizer::OnUpdate(float deltaTime)
+	{
+	}
+
+	void TestMeshOptimizer::OnUpdate(float deltaTime, FramePacket& packet)
+	{
+		// Creating the buffers needs the context. The build replaces the stats ImGui
+		// reads, so only the frames that rebuild are waited for
+		if (m_Resolution != m_BuiltResolution || m_Compressed != m_BuiltCompressed)
+		{
+			int resolution = m_Resolution;
+			bool compressed = m_Compressed;
+			int threads = m_Threads;
+			packet.AddCallback([this, resolution, compressed, threads]() { BuildMeshes(resolution, compressed, threads); });
+			packet.SetSynchronous();
+			m_BuiltResolution = m_Resolution;
+			m_BuiltCompressed = m_Compressed;
+		}
+
+		bool optimized = m_DrawOptimized;
+		bool compressed = m_BuiltCompressed;
+		packet.AddCallback([this, optimized, compressed]() { Draw(optimized, compressed); });
+	}
+
+	void TestMeshOptimizer::OnRender()
+	{
+		if (m_Resolution != m_BuiltResolution || m_Compressed != m_BuiltCompressed)
+		{
+			BuildMeshes(m_Resolution, m_Compressed, m_Threads);
+			m_BuiltResolution = m_Resolution;
+			m_BuiltCompressed = m_Compressed;
+		}
+		Draw(m_DrawOptimized, m_BuiltCompressed);
+	}
+
+	void TestMeshOptimizer::Draw(bool optimized, bool compressed)
+	{
+
+		GLCall(glClearColor(0.0f, 0.0f, 0.0f, 1.0f));
+		GLCall(glClear(GL_COLOR_BUFFER_BIT));
+
+		Renderer renderer;
+		m_Shader->Bind();
+		m_Shader->SetUniformMat4f("u_ViewProj", m_Camera.GetViewProjection());
+
+		// With direct state access swapping the buffer is a single call that binds nothing
+		VertexArray& va = compressed ? *m_CompressedVAO : *m_VAO;
+		const std::vector<Mesh>& meshes = optimized ? m_Optimized : m_Original;
+		for (const Mesh& mesh : meshes)
+		{
+			va.SetVertexBuffer(0, *mesh.VBO);
+			renderer.Draw(va, *mesh.IBO, *m_Shader);
+		}
+	}
+
+	void TestMeshOptimizer::OnImGuiRender()
+	{
+		ImGui::SliderInt("Grid resolution", &m_Resolution, 8, 400);
+		ImGui::SliderInt("Threads", &m_Threads, 1, 32);
+		if (ImGui::Button("Rebuild"))
+			m_BuiltResolution = 0;
+		ImGui::Checkbox("Draw optimized meshes", &m_DrawOptimized);
+		ImGui::Checkbox("Compressed vertices (12 instead of 24 bytes)", &m_Compressed);
+
+		float before = 0.0f, after = 0.0f;
+		for (const MeshOptimizeStats& stats : m_Stats)
+		{
+			before += stats.ACMRBefore;
+			after += stats.ACMRAfter;
+		}
+		ImGui::Text("%d meshes of %d triangles, optimized in %.1f ms", MeshCount, m_BuiltResolution * m_BuiltResolution * 2, m_OptimizeTime);
+		ImGui::Text("ACMR (FIFO of 16): %.3f before, %.3f after", before / m_Stats.size(), after / m_Stats.size());
+		ImGui::Text("2 vertex arrays for %d meshes, buffers swapped %s", MeshCount * 2,
+			m_VAO->IsDirectStateAccess() ? "with direct state access" : "by setting the attribute pointers again");
+		ImGui::Text("Application average %.3f ms/frame (%.1f FPS)", 1000.0f / ImGui::GetIO().Framerate, ImGui::GetIO().Framerate);
+	}
+}
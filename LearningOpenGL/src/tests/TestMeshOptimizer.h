@@ -0,0 +1,66 @@
+#pragma once
+
+#include "Test.h"
+
+#include "Renderer.h"
+#include "VertexBuffer.h"
+#include "VertexBufferLayout.h"
+#include "Camera.h"
+#include "MeshOptimizer.h"
+
+#include <memory>
+#include <vector>
+
+namespace test{
+
+	// Grid meshes with their triangles and vertices shuffled, as a stand-in for badly ordered
+	// imported models, drawn either as they are or after MeshOptimizer
+	class TestMeshOptimizer : public Test
+	{
+	public:
+		TestMeshOptimizer();
+		~TestMeshOptimizer();
+
+		void OnUpdate(float deltaTime) override;
+		void OnUpdate(float deltaTime, FramePacket& packet) override;
+		void OnRender() override;
+		void OnImGuiRender() override;
+
+	private:
+		// the GPU side of one MeshSource
+		struct Mesh
+		{
+			std::unique_ptr<VertexBuffer> VBO;
+			std::unique_ptr<IndexBuffer> IBO;
+		};
+
+		static const int MeshCount = 8;
+
+		// generates the meshes, optimises a copy of them and uploads both versions
+		void BuildMeshes(int resolution, bool compressed, int threads);
+		void Draw(bool optimized, bool compressed);
+		// compressed stores positions as half floats and colors as normalized shorts, 12 bytes instead of 24
+		static Mesh Upload(const MeshSource& source, bool compressed);
+
+		std::unique_ptr<Shader> m_Shader;
+		OrthographicCamera m_Camera;
+
+		// one vertex array per vertex format, every mesh swaps its buffer into binding 0
+		std::unique_ptr<VertexArray> m_VAO;
+		std::unique_ptr<VertexArray> m_CompressedVAO;
+
+		std::vector<Mesh> m_Original;
+		std::vector<Mesh> m_Optimized;
+		std::vector<MeshOptimizeStats> m_Stats;
+
+		// quads along each side of a grid
+		int m_Resolution;
+		// main thread only, the build itself happens where the context is
+		int m_BuiltResolution;
+		int m_Threads;
+		float m_OptimizeTime;
+		bool m_DrawOptimized;
+		bool m_Compressed;
+		bool m_BuiltCompressed;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,172 @@
+#include "TestRenderQueue.h"
+
+#include "imgui/imgui.h"
+#include "FramePacket.h"
+
+#include "glm/glm.hpp"
+#include "glm/gtc/matrix_transform.hpp"
+
+#include <cmath>
+
+namespace test {
+	TestRenderQueue::TestRenderQueue()
+		: m_Proj(glm::ortho(0.0f, 960.0f, 0.0f, 540.0f, -1.0f, 1.0f)),
+		m_View(glm::translate(glm::mat4(1.0f), glm::vec3(0, 0, 0))),
+		m_ObjectCount(1000), m_UseQueue(true), m_Transparent(false), m_DepthTest(false), m_StateChanges(0), m_SortTime(0.0f)
+	{
+		// Enable blending of alpha (layers of transparency in textures)
+		GLCall(glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA));
+		GLCall(glEnable(GL_BLEND));
+
+		// Geometric data of two squares with texture coordinates (x, y, normal_x, normal_y)
+		float positions[2][16] = {
+			{
+				-4.0f, -4.0f, 0.0f, 0.0f,
+				 4.0f, -4.0f, 1.0f, 0.0f,
+				 4.0f,  4.0f, 1.0f, 1.0f,
+				-4.0f,  4.0f, 0.0f, 1.0f,
+			},
+			{
+				-8.0f, -8.0f, 0.0f, 0.0f,
+				 8.0f, -8.0f, 1.0f, 0.0f,
+				 8.0f,  8.0f, 1.0f, 1.0f,
+				-8.0f,  8.0f, 0.0f, 1.0f,
+			}
+		};
+
+		VertexBufferLayout layout;
+		layout.Push<float>(2);
+		layout.Push<float>(2);
+
+		for (int i = 0; i < 2; i++)
+		{
+			m_VertexBuffer[i] = std::make_unique<VertexBuffer>(positions[i], 4 * 4 * sizeof(float));
+			m_VAO[i] = std::make_unique<VertexArray>();
+			m_VAO[i]->AddBuffer(*m_VertexBuffer[i], layout);
+		}
+
+		unsigned int indices[] = {
+			0, 1, 2,
+			2, 3, 0
+		};
+		m_IndexBuffer = std::make_unique<IndexBuffer>(indices, 6);
+
+		m_Shader = std::make_unique<Shader>("res/shaders/Basic.shader");
+		m_Shader->Bind();
+		m_Shader->SetUniform1i("u_Texture", 0);
+
+		m_Textures[0] = std::make_unique<Texture>("res/textures/Nessarus3.png");
+		m_Textures[1] = std::make_unique<Texture>("res/textures/Nessarus4.png");
+		m_Textures[2] = std::make_unique<Texture>("res/textures/Nu Final.png");
+	}
+
+	TestRenderQueue::~TestRenderQueue()
+	{
+	}
+
+	glm::mat4 TestRenderQueue::GetMVP(int index, int columns, const glm::mat4& viewProj) const
+	{
+		glm::vec2 spacing(960.0f / columns, 540.0f / columns);
+		// depth 0 lands on the near plane of the [-1, 1] z range of m_Proj, depth 1 on the far one
+		glm::vec3 translation((index % columns + 0.5f) * spacing.x, (index / columns + 0.5f) * spacing.y, 1.0f - 2.0f * GetDepth(index));
+		glm::mat4 model = glm::translate(glm::mat4(1.0f), translation);
+		if (m_DepthTest)
+			model = glm::scale(model, glm::vec3(spacing.x / 4.0f, spacing.x / 4.0f, 1.0f));
+		return viewProj * model;
+	}
+
+	float TestRenderQueue::GetDepth(int index) const
+	{
+		float depth = index * 0.618034f;
+		return depth - std::floor(depth);
+	}
+
+	void TestRenderQueue::OnUpdate(float deltaTime)
+	{
+	}
+
+	void TestRenderQueue::OnUpdate(float deltaTime, FramePacket& packet)
+	{
+		// Only records the draws, the render thread sorts and draws them during the next update
+		int columns = (int)std::ceil(std::sqrt((float)m_ObjectCount));
+		glm::mat4 viewProj = m_Proj * m_View;
+
+		packet.SetDepthTest(m_DepthTest);
+		for (int i = 0; i < m_ObjectCount; i++)
+			packet.Submit({ m_VAO[i % 2].get(), m_IndexBuffer.get(), m_Shader.get(), m_Textures[i % 3].get(), GetMVP(i, columns, viewProj) },
+				0, GetDepth(i), m_Transparent);
+	}
+
+	void TestRenderQueue::OnRender()
+	{
+		GLCall(glClearColor(0.0f, 0.0f, 0.0f, 1.0f));
+		GLCall(glClear(GL_COLOR_BUFFER_BIT));
+		if (m_DepthTest)
+		{
+			GLCall(glClear(GL_DEPTH_BUFFER_BIT));
+			GLCall(glEnable(GL_DEPTH_TEST));
+		}
+
+		int columns = (int)std::ceil(std::sqrt((float)m_ObjectCount));
+		glm::mat4 viewProj = m_Proj * m_View;
+
+		m_StateChanges = 0;
+		GLStateCache::ResetStats();
+		for (int i = 0; i < m_ObjectCount; i++)
+		{
+			glm::mat4 mvp = GetMVP(i, columns, viewProj);
+
+			// neighbours never share both mesh and texture, the worst case for submission order
+			const VertexArray& va = *m_VAO[i % 2];
+			const Texture& texture = *m_Textures[i % 3];
+
+			if (m_UseQueue && m_Transparent)
+			{
+				m_Renderer.SubmitTransparent(va, *m_IndexBuffer, *m_Shader, &texture, mvp, 0, GetDepth(i));
+			}
+			else if (m_UseQueue)
+			{
+				m_Renderer.Submit(va, *m_IndexBuffer, *m_Shader, &texture, mvp, 0, GetDepth(i));
+			}
+			else
+			{
+				// Renderer::Draw binds shader and vertex array every time, plus the texture bind
+				texture.Bind();
+				m_Shader->Bind();
+				m_Shader->SetUniformMat4f("u_MVP", mvp);
+				m_Renderer.Draw(va, *m_IndexBuffer, *m_Shader);
+				m_StateChanges += 3;
+			}
+		}
+
+		if (m_UseQueue)
+		{
+			m_Renderer.FlushQueue();
+			const QueueStats& stats = m_Transparent ? m_Renderer.GetTransparentQueueStats() : m_Renderer.GetQueueStats();
+			m_StateChanges = stats.GetStateChanges();
+			m_SortTime = stats.SortTime;
+		}
+
+		// ImGui and the other tests draw without it
+		if (m_DepthTest)
+		{
+			GLCall(glDisable(GL_DEPTH_TEST));
+		}
+
+		m_CacheStats = GLStateCache::GetStats();
+	}
+
+	void TestRenderQueue::OnImGuiRender()
+	{
+		ImGui::SliderInt("Objects", &m_ObjectCount, 1, 200000);
+		ImGui::Checkbox("Sort by render queue", &m_UseQueue);
+		// transparent objects are sorted back to front instead of by state, so expect more state changes
+		ImGui::Checkbox("Transparent (back to front)", &m_Transparent);
+		// the opaque queue draws near objects first, so most hidden pixels fail the depth test before shading
+		ImGui::Checkbox("Depth test (overlapping objects)", &m_DepthTest);
+		ImGui::Text("State changes: %u", m_StateChanges);
+		ImGui::Text("Sort time: %.3f ms", m_SortTime);
+		ImGui::Text("State cache: %u binds skipped, %u sent to OpenGL", m_CacheStats.Hits, m_CacheStats.Misses);
+		ImGui::Text("Application average %.3f ms/frame (%.1f FPS)", 1000.0f / ImGui::GetIO().Framerate, ImGui::GetIO().Framerate);
+	}
+}
\ No newline at end of file
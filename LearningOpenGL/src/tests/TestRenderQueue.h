@@ -0,0 +1,55 @@
+#pragma once
+
+#include "Test.h"
+
+#include "Renderer.h"
+#include "GLStateCache.h"
+#include "VertexBuffer.h"
+#include "VertexBufferLayout.h"
+#include "Texture.h"
+
+#include <memory>
+
+namespace test{
+
+	class TestRenderQueue : public Test
+	{
+	public:
+		TestRenderQueue();
+		~TestRenderQueue();
+
+		void OnUpdate(float deltaTime) override;
+		void OnUpdate(float deltaTime, FramePacket& packet) override;
+		void OnRender() override;
+		void OnImGuiRender() override;
+
+	private:
+		// grid position and depth of object index as a model view projection matrix
+		glm::mat4 GetMVP(int index, int columns, const glm::mat4& viewProj) const;
+		// scattered depth in [0, 1) so the transparent queue has something to sort
+		float GetDepth(int index) const;
+
+		Renderer m_Renderer;
+
+		// two meshes (small and large square) so vertex arrays change too
+		std::unique_ptr<VertexArray> m_VAO[2];
+		std::unique_ptr<VertexBuffer> m_VertexBuffer[2];
+		std::unique_ptr<IndexBuffer> m_IndexBuffer;
+		std::unique_ptr<Shader> m_Shader;
+		std::unique_ptr<Texture> m_Textures[3];
+
+		glm::mat4 m_Proj;
+		glm::mat4 m_View;
+
+		int m_ObjectCount;
+		bool m_UseQueue;
+		bool m_Transparent;
+		// depth tested and scaled up to overlap, so drawing front to back has hidden pixels to reject
+		bool m_DepthTest;
+
+		// state changes of the last frame
+		unsigned int m_StateChanges;
+		float m_SortTime;
+		StateCacheStats m_CacheStats;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,112 @@
+#include "TestSpriteStore.h"
+
+#include "imgui/imgui.h"
+
+#include "glm/glm.hpp"
+
+namespace test {
+	TestSpriteStore::TestSpriteStore()
+		: m_Camera(960.0f, 540.0f), m_Random(1), m_MaxBatchTextures(Renderer::GetMaxBatchTextures()),
+		m_SpriteCount(20000), m_TextureCount(3), m_UsedTextures(3), m_Churn(100), m_Spin(1.0f), m_LastStats(BatchStats())
+	{
+		// Enable blending of alpha (layers of transparency in textures)
+		GLCall(glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA));
+		GLCall(glEnable(GL_BLEND));
+
+		m_Shader = std::make_unique<Shader>("res/shaders/Batch.shader");
+		const char* images[3] = { "res/textures/Nessarus3.png", "res/textures/Nessarus4.png", "res/textures/Nu Final.png" };
+		for (int i = 0; i < MaxTextures; i++)
+			m_Textures[i] = std::make_unique<Texture>(images[i % 3]);
+	}
+
+	TestSpriteStore::~TestSpriteStore()
+	{
+	}
+
+	void TestSpriteStore::AddSprite()
+	{
+		std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+		glm::vec2 position(unit(m_Random) * 960.0f, unit(m_Random) * 540.0f);
+		glm::vec4 color(unit(m_Random), unit(m_Random), unit(m_Random), 1.0f);
+		unsigned int texture = m_Random() % m_UsedTextures;
+
+		// layer follows the image here, so the images stack in a fixed order
+		m_Handles.push_back(m_Sprites.Add(position, glm::vec2(8.0f + 8.0f * unit(m_Random)), *m_Textures[texture],
+			unit(m_Random) * 6.2831853f, glm::vec4(0.0f, 0.0f, 1.0f, 1.0f), color, texture % 3));
+	}
+
+	void TestSpriteStore::OnUpdate(float deltaTime)
+	{
+		// Spread the existing sprites over the new number of textures
+		if (m_TextureCount != m_UsedTextures)
+		{
+			m_UsedTextures = m_TextureCount;
+			for (SpriteHandle sprite : m_Handles)
+			{
+				unsigned int texture = m_Random() % m_UsedTextures;
+				m_Sprites.SetTexture(sprite, *m_Textures[texture]);
+				m_Sprites.SetLayer(sprite, texture % 3);
+			}
+		}
+
+		while ((int)m_Sprites.GetCount() < m_SpriteCount)
+			AddSprite();
+
+		// Removing through random handles, each one swaps the last sprite into the hole
+		int churn = (int)m_Sprites.GetCount() - m_SpriteCount + m_Churn;
+		for (int i = 0; i < churn && !m_Handles.empty(); i++)
+		{
+			unsigned int pick = m_Random() % m_Handles.size();
+			m_Sprites.Remove(m_Handles[pick]);
+			m_Handles[pick] = m_Handles.back();
+			m_Handles.pop_back();
+		}
+		while ((int)m_Sprites.GetCount() < m_SpriteCount)
+			AddSprite();
+
+		// One property of every sprite, one tight loop over one array
+		float* rotations = m_Sprites.GetRotations();
+		float step = m_Spin * deltaTime;
+		for (unsigned int i = 0; i < m_Sprites.GetCount(); i++)
+			rotations[i] += step;
+	}
+
+	void TestSpriteStore::OnUpdate(float deltaTime, FramePacket& packet)
+	{
+		OnUpdate(deltaTime);
+
+		m_Snapshot.Get() = m_Sprites;
+		m_Snapshot.Submit(packet, [this](const SpriteStore& sprites) { Draw(sprites); });
+	}
+
+	void TestSpriteStore::OnRender()
+	{
+		Draw(m_Sprites);
+	}
+
+	void TestSpriteStore::Draw(const SpriteStore& sprites)
+	{
+		GLCall(glClearColor(0.0f, 0.0f, 0.0f, 1.0f));
+		GLCall(glClear(GL_COLOR_BUFFER_BIT));
+
+		m_Renderer.ResetBatchStats();
+		m_Renderer.BeginBatch(*m_Shader, m_Camera);
+		m_Renderer.DrawSprites(sprites);
+		m_Renderer.EndBatch();
+
+		m_LastStats.store(m_Renderer.GetBatchStats());
+	}
+
+	void TestSpriteStore::OnImGuiRender()
+	{
+		ImGui::SliderInt("Sprites", &m_SpriteCount, 1, 100000);
+		ImGui::SliderInt("Textures", &m_TextureCount, 1, MaxTextures);
+		ImGui::Text("Texture slots per batch: %u", m_MaxBatchTextures);
+		ImGui::SliderInt("Removed and added per frame", &m_Churn, 0, 1000);
+		ImGui::SliderFloat("Spin", &m_Spin, -5.0f, 5.0f);
+		BatchStats stats = m_LastStats.load();
+		ImGui::Text("Draw calls: %u", stats.DrawCalls);
+		ImGui::Text("Quads: %u", stats.QuadCount);
+		ImGui::Text("Application average %.3f ms/frame (%.1f FPS)", 1000.0f / ImGui::GetIO().Framerate, ImGui::GetIO().Framerate);
+	}
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "Test.h"
+
+#include "Renderer.h"
+#include "Texture.h"
+#include "Camera.h"
+#include "SpriteStore.h"
+#include "FramePacket.h"
+
+#include <atomic>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace test{
+
+	class TestSpriteStore : public Test
+	{
+	public:
+		TestSpriteStore();
+		~TestSpriteStore();
+
+		void OnUpdate(float deltaTime) override;
+		void OnUpdate(float deltaTime, FramePacket& packet) override;
+		void OnRender() override;
+		void OnImGuiRender() override;
+
+	private:
+		void AddSprite();
+		void Draw(const SpriteStore& sprites);
+
+		Renderer m_Renderer;
+
+		std::unique_ptr<Shader> m_Shader;
+		// separate textures loaded from the three images, to fill the batch's texture slots
+		static const int MaxTextures = 40;
+		std::unique_ptr<Texture> m_Textures[MaxTextures];
+
+		OrthographicCamera m_Camera;
+
+		// all sprite data lives in the store, the test only keeps handles to remove sprites again
+		SpriteStore m_Sprites;
+		std::vector<SpriteHandle> m_Handles;
+		// the sprites the render thread draws
+		FrameSnapshot<SpriteStore> m_Snapshot;
+		std::mt19937 m_Random;
+
+		// queried with the context, OnImGuiRender may run on a thread without it
+		unsigned int m_MaxBatchTextures;
+
+		int m_SpriteCount;
+		int m_TextureCount;
+		int m_UsedTextures;
+		// sprites removed and re-added every frame
+		int m_Churn;
+		float m_Spin;
+
+		// written by whichever thread draws, read by OnImGuiRender
+		std::atomic<BatchStats> m_LastStats;
+	};
+}
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 #include "Renderer.h"
 #include "imgui/imgui.h"
+#include "FramePacket.h"
 
 
 
@@ -10,10 +11,12 @@
 
 namespace test {
 	TestTexture2D::TestTexture2D()
-		: m_Proj(glm::ortho(0.0f, 960.0f, 0.0f, 540.0f, -1.0f, 1.0f)), 
-		m_View(glm::translate(glm::mat4(1.0f), glm::vec3(0, 0, 0))),
-		m_TranslationA(200, 200, 0), m_TranslationB(400, 200, 0) 
+		: m_Camera(960.0f, 540.0f), m_CameraPosition(0.0f), m_Zoom(1.0f), m_UploadedCamera(0)
 	{
+		// setting up nodes to move icons
+		m_NodeA = m_Transforms.Add(TransformHierarchy::NoParent, glm::vec3(200, 200, 0));
+		m_NodeB = m_Transforms.Add(TransformHierarchy::NoParent, glm::vec3(400, 200, 0));
+
 		// Enable blending of alpha (layers of transparency in textures)
 		GLCall(glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA));
 		GLCall(glEnable(GL_BLEND));
@@ -48,11 +51,10 @@ namespace test {
 		m_VAO->AddBuffer(*m_VertexBuffer, layout);
 
 		// Setting up shaders
-		m_Shader = std::make_unique<Shader>("res/shaders/Basic.shader");
+		// The camera block of the shader reads projection and view from m_CameraBuffer
+		m_Shader = std::make_unique<Shader>("res/shaders/Camera.shader");
 		m_Shader->Bind();
-
-		// Set data (color: pink) into new variable "u_Color"
-		m_Shader->SetUniform4f("u_Color", 0.8f, 0.3f, 0.8f, 1.0f);
+		m_CameraBuffer = std::make_unique<UniformBuffer>(sizeof(CameraUniforms), UniformBuffer::CameraBinding);
 
 		// Setting up textures
 		m_Texture = std::make_unique<Texture>("res/textures/Nu Final.png");
@@ -76,31 +78,55 @@ namespace test {
 	
 	void TestTexture2D::OnUpdate(float deltaTime)
 	{
+		// no-ops unless the sliders moved
+		m_Camera.SetPosition(m_CameraPosition);
+		m_Camera.SetZoom(m_Zoom);
+
+		m_Transforms.Update();
+	}
+	
+	void TestTexture2D::OnUpdate(float deltaTime, FramePacket& packet)
+	{
+		OnUpdate(deltaTime);
+
+		// The sliders move the camera and the nodes again while this frame is drawn, so the render thread gets copies
+		m_Camera.Refresh();
+		OrthographicCamera camera = m_Camera;
+		glm::mat4 modelA = m_Transforms.GetWorldMatrix(m_NodeA);
+		glm::mat4 modelB = m_Transforms.GetWorldMatrix(m_NodeB);
+		packet.AddCallback([this, camera, modelA, modelB]() { Draw(camera, modelA, modelB); });
 	}
 	
 	void TestTexture2D::OnRender()
+	{
+		Draw(m_Camera, m_Transforms.GetWorldMatrix(m_NodeA), m_Transforms.GetWorldMatrix(m_NodeB));
+	}
+	
+	void TestTexture2D::Draw(const OrthographicCamera& camera, const glm::mat4& modelA, const glm::mat4& modelB)
 	{
 		GLCall(glClearColor(0.0f, 0.0f, 0.0f, 1.0f));
 		GLCall(glClear(GL_COLOR_BUFFER_BIT));
 
 		Renderer renderer;
 
+		// Camera matrices are uploaded once when they change, not once per object
+		if (camera.GetVersion() != m_UploadedCamera)
+		{
+			renderer.SetCamera(camera, *m_CameraBuffer);
+			m_UploadedCamera = camera.GetVersion();
+		}
+		m_CameraBuffer->Bind();
+
 		// Binding texture
 		m_Texture->Bind();
 
+		// Rebinding buffers
+		m_Shader->Bind();
+
 		// first icon draw
 		{
-			// the model matrix
-			glm::mat4 model = glm::translate(glm::mat4(1.0f), m_TranslationA);
-
-			// multiplying a translation matrices together to get final image
-			glm::mat4 mvp = m_Proj * m_View * model;
-
-			// Rebinding buffers
-			m_Shader->Bind();
-
-			// Setting uniform to pass in projection into vertex shader
-			m_Shader->SetUniformMat4f("u_MVP", mvp);
+			// the model matrix, the shader multiplies it with the camera
+			m_Shader->SetUniformMat4f("u_Model", modelA);
 
 			// Drawing primitives using the vertex array, index buffer and shader
 			renderer.Draw(*m_VAO, *m_IndexBuffer, *m_Shader);
@@ -109,16 +135,7 @@ namespace test {
 		// second icon draw
 		{
 			// the model matrix
-			glm::mat4 model = glm::translate(glm::mat4(1.0f), m_TranslationB);
-
-			// multiplying a translation matrices together to get final image
-			glm::mat4 mvp = m_Proj * m_View * model;
-
-			// Rebinding buffers
-			m_Shader->Bind();
-
-			// Setting uniform to pass in projection into vertex shader
-			m_Shader->SetUniformMat4f("u_MVP", mvp);
+			m_Shader->SetUniformMat4f("u_Model", modelB);
 
 			// Drawing primitives using the vertex array, index buffer and shader
 			renderer.Draw(*m_VAO, *m_IndexBuffer, *m_Shader);
@@ -127,9 +144,17 @@ namespace test {
 	
 	void TestTexture2D::OnImGuiRender()
 	{
-		// Creating UI window
-		ImGui::SliderFloat3("Translation A", &m_TranslationA.x, 0.0f, 960.0f);
-		ImGui::SliderFloat3("Translation B", &m_TranslationB.x, 0.0f, 960.0f);
+		// Creating UI window, nodes are only marked as moved when a slider changed them
+		glm::vec3 translationA = m_Transforms.GetTranslation(m_NodeA);
+		if (ImGui::SliderFloat3("Translation A", &translationA.x, 0.0f, 960.0f))
+			m_Transforms.SetTranslation(m_NodeA, translationA);
+
+		glm::vec3 translationB = m_Transforms.GetTranslation(m_NodeB);
+		if (ImGui::SliderFloat3("Translation B", &translationB.x, 0.0f, 960.0f))
+			m_Transforms.SetTranslation(m_NodeB, translationB);
+
+		ImGui::SliderFloat2("Camera", &m_CameraPosition.x, -480.0f, 480.0f);
+		ImGui::SliderFloat("Zoom", &m_Zoom, 0.25f, 4.0f);
 		ImGui::Text("Application average %.3f ms/frame (%.1f FPS)", 1000.0f / ImGui::GetIO().Framerate, ImGui::GetIO().Framerate);
 	}
 }
\ No newline at end of file
@@ -5,6 +5,9 @@
 #include "VertexBuffer.h"
 #include "VertexBufferLayout.h"
 #include "Texture.h"
+#include "UniformBuffer.h"
+#include "Camera.h"
+#include "TransformHierarchy.h"
 
 #include <memory>
 
@@ -17,25 +20,31 @@ namespace test{
 		~TestTexture2D();
 
 		void OnUpdate(float deltaTime) override;
+		void OnUpdate(float deltaTime, FramePacket& packet) override;
 		void OnRender() override;
 		void OnImGuiRender() override;
 
 	private:
+		void Draw(const OrthographicCamera& camera, const glm::mat4& modelA, const glm::mat4& modelB);
+
 		// smart pointers to variables
 		std::unique_ptr<VertexArray> m_VAO;
 		std::unique_ptr<VertexBuffer> m_VertexBuffer;
 		std::unique_ptr<IndexBuffer> m_IndexBuffer;
 		std::unique_ptr<Shader> m_Shader;
 		std::unique_ptr<Texture> m_Texture;
-
-		// Creating a orthographic view matrix
-		glm::mat4 m_Proj;
-
-		// translation matrix to position of all objects right (moving camera left)
-		glm::mat4 m_View;
-
-		// setting up varables to move icons
-		glm::vec3 m_TranslationA, m_TranslationB;
+		std::unique_ptr<UniformBuffer> m_CameraBuffer;
+
+		// orthographic camera, its matrices are only rebuilt when it moves or zooms
+		OrthographicCamera m_Camera;
+		glm::vec3 m_CameraPosition;
+		float m_Zoom;
+		// camera version last uploaded to m_CameraBuffer, only touched while drawing
+		unsigned int m_UploadedCamera;
+
+		// the two icons as nodes, their world matrices are only rebuilt after they move
+		TransformHierarchy m_Transforms;
+		unsigned int m_NodeA, m_NodeB;
 
 	};
 }
\ No newline at end of file
@@ -0,0 +1,118 @@
+#include "TestTextureAtlas.h"
+
+#include "imgui/imgui.h"
+#include "FramePacket.h"
+
+#include "glm/glm.hpp"
+#include "glm/gtc/matrix_transform.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+namespace test {
+	TestTextureAtlas::TestTextureAtlas()
+		: m_Camera(960.0f, 540.0f), m_Copies(10), m_BuiltCopies(0),
+		m_Threads((int)std::thread::hardware_concurrency()), m_BuildTime(0.0f), m_LastStats(BatchStats())
+	{
+		// Enable blending of alpha (layers of transparency in textures)
+		GLCall(glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA));
+		GLCall(glEnable(GL_BLEND));
+
+		m_Shader = std::make_unique<Shader>("res/shaders/Batch.shader");
+		if (m_Threads < 1)
+			m_Threads = 1;
+
+		BuildAtlas(m_Copies, m_Threads);
+		m_BuiltCopies = m_Copies;
+	}
+
+	TestTextureAtlas::~TestTextureAtlas()
+	{
+	}
+
+	void TestTextureAtlas::BuildAtlas(int copies, int threads)
+	{
+		// small images are packed around the large ones, the largest spill into further atlases
+		m_Atlas = std::make_unique<AtlasBuilder>();
+		for (int i = 0; i < copies; i++)
+		{
+			m_Atlas->Add("res/textures/Nessarus3.png");
+			m_Atlas->Add("res/textures/Nessarus4.png");
+			m_Atlas->Add("res/textures/Nu Final.png");
+		}
+
+		auto start = std::chrono::high_resolution_clock::now();
+		m_Atlas->Build(threads);
+		auto end = std::chrono::high_resolution_clock::now();
+		m_BuildTime = std::chrono::duration<float, std::milli>(end - start).count();
+	}
+
+	void TestTextureAtlas::OnUpdate(float deltaTime)
+	{
+	}
+
+	void TestTextureAtlas::OnUpdate(float deltaTime, FramePacket& packet)
+	{
+		// Uploading the atlases needs the context. The build replaces the atlases ImGui
+		// reads, so only the frames that rebuild are waited for
+		if (m_Copies != m_BuiltCopies)
+		{
+			int copies = m_Copies;
+			int threads = m_Threads;
+			packet.AddCallback([this, copies, threads]() { BuildAtlas(copies, threads); });
+			packet.SetSynchronous();
+			m_BuiltCopies = m_Copies;
+		}
+		packet.AddCallback([this]() { Draw(); });
+	}
+
+	void TestTextureAtlas::OnRender()
+	{
+		if (m_Copies != m_BuiltCopies)
+		{
+			BuildAtlas(m_Copies, m_Threads);
+			m_BuiltCopies = m_Copies;
+		}
+		Draw();
+	}
+
+	void TestTextureAtlas::Draw()
+	{
+
+		GLCall(glClearColor(0.0f, 0.0f, 0.0f, 1.0f));
+		GLCall(glClear(GL_COLOR_BUFFER_BIT));
+
+		// Every image once in a grid, each one a region of some atlas
+		unsigned int count = m_Atlas->GetImageCount();
+		int columns = (int)std::ceil(std::sqrt((float)count));
+		glm::vec2 cell = glm::vec2(960.0f, 540.0f) / (float)columns;
+
+		m_Renderer.ResetBatchStats();
+		m_Renderer.BeginBatch(*m_Shader, m_Camera);
+		for (unsigned int i = 0; i < count; i++)
+		{
+			const AtlasRegion& region = m_Atlas->GetRegion(i);
+			if (region.Atlas == AtlasBuilder::InvalidAtlas)
+				continue;
+
+			glm::vec3 center((i % columns + 0.5f) * cell.x, (i / columns + 0.5f) * cell.y, 0.0f);
+			glm::mat4 transform = glm::scale(glm::translate(glm::mat4(1.0f), center), glm::vec3(cell * 0.9f, 1.0f));
+			m_Renderer.DrawQuad(transform, m_Atlas->GetAtlas(region.Atlas), region.TexRect);
+		}
+		m_Renderer.EndBatch();
+
+		m_LastStats.store(m_Renderer.GetBatchStats());
+	}
+
+	void TestTextureAtlas::OnImGuiRender()
+	{
+		ImGui::SliderInt("Copies of each image", &m_Copies, 1, 200);
+		ImGui::SliderInt("Threads", &m_Threads, 1, 32);
+		if (ImGui::Button("Rebuild"))
+			m_BuiltCopies = 0;
+		ImGui::Text("Images: %u in %u atlases, built in %.1f ms", m_Atlas->GetImageCount(), m_Atlas->GetAtlasCount(), m_BuildTime);
+		ImGui::Text("Draw calls: %u", m_LastStats.load().DrawCalls);
+		ImGui::Text("Application average %.3f ms/frame (%.1f FPS)", 1000.0f / ImGui::GetIO().Framerate, ImGui::GetIO().Framerate);
+	}
+}
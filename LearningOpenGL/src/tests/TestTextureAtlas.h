@@ -0,0 +1,47 @@
+#pragma once
+
+#include "Test.h"
+
+#include "Renderer.h"
+#include "Texture.h"
+#include "Camera.h"
+#include "AtlasBuilder.h"
+
+#include <atomic>
+#include <memory>
+
+namespace test{
+
+	class TestTextureAtlas : public Test
+	{
+	public:
+		TestTextureAtlas();
+		~TestTextureAtlas();
+
+		void OnUpdate(float deltaTime) override;
+		void OnUpdate(float deltaTime, FramePacket& packet) override;
+		void OnRender() override;
+		void OnImGuiRender() override;
+
+	private:
+		// packs copies of every image in res/textures
+		void BuildAtlas(int copies, int threads);
+		void Draw();
+
+		Renderer m_Renderer;
+
+		std::unique_ptr<Shader> m_Shader;
+		std::unique_ptr<AtlasBuilder> m_Atlas;
+
+		OrthographicCamera m_Camera;
+
+		int m_Copies;
+		// main thread only, the build itself happens where the context is
+		int m_BuiltCopies;
+		int m_Threads;
+		float m_BuildTime;
+
+		// written while drawing
+		std::atomic<BatchStats> m_LastStats;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,109 @@
+#include "TestTransformHierarchy.h"
+
+#include "imgui/imgui.h"
+
+#include "glm/glm.hpp"
+
+#include <chrono>
+#include <cmath>
+
+namespace test {
+	// nodes per system: sun, two planets and their moons
+	static const int NodesPerSystem = 5;
+
+	TestTransformHierarchy::TestTransformHierarchy()
+		: m_Camera(960.0f, 540.0f), m_SystemCount(10000), m_BuiltCount(0), m_MovingPercent(1.0f), m_Angle(0.0f),
+		m_UpdatedNodes(0), m_UpdateTime(0.0f)
+	{
+		// Enable blending of alpha (layers of transparency in textures)
+		GLCall(glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA));
+		GLCall(glEnable(GL_BLEND));
+
+		m_Shader = std::make_unique<Shader>("res/shaders/Batch.shader");
+		m_Texture = std::make_unique<Texture>("res/textures/Nu Final.png");
+	}
+
+	TestTransformHierarchy::~TestTransformHierarchy()
+	{
+	}
+
+	void TestTransformHierarchy::BuildSystems()
+	{
+		int columns = (int)std::ceil(std::sqrt((float)m_SystemCount));
+		glm::vec2 spacing = glm::vec2(960.0f, 540.0f) / (float)columns;
+
+		m_Transforms.Clear();
+		m_Transforms.Reserve(m_SystemCount * NodesPerSystem);
+
+		// Children are placed in their parent's units, so they scale with it
+		for (int i = 0; i < m_SystemCount; i++)
+		{
+			glm::vec3 center((i % columns + 0.5f) * spacing.x, (i / columns + 0.5f) * spacing.y, 0.0f);
+			unsigned int sun = m_Transforms.Add(TransformHierarchy::NoParent, center,
+				glm::quat(1.0f, 0.0f, 0.0f, 0.0f), glm::vec3(spacing.y * 0.3f));
+
+			for (int planet = 0; planet < 2; planet++)
+			{
+				float side = planet == 0 ? 1.0f : -1.0f;
+				unsigned int planetNode = m_Transforms.Add(sun, glm::vec3(side * 1.2f, 0.0f, 0.0f),
+					glm::quat(1.0f, 0.0f, 0.0f, 0.0f), glm::vec3(0.5f));
+				m_Transforms.Add(planetNode, glm::vec3(0.0f, 1.2f, 0.0f), glm::quat(1.0f, 0.0f, 0.0f, 0.0f), glm::vec3(0.5f));
+			}
+		}
+
+		m_BuiltCount = m_SystemCount;
+	}
+
+	void TestTransformHierarchy::OnUpdate(float deltaTime)
+	{
+		if (m_SystemCount != m_BuiltCount)
+			BuildSystems();
+
+		// Only the suns of the moving systems are touched, their planets and moons follow
+		m_Angle += deltaTime;
+		glm::quat rotation = glm::angleAxis(m_Angle, glm::vec3(0.0f, 0.0f, 1.0f));
+		int moving = (int)(m_SystemCount * m_MovingPercent / 100.0f);
+		for (int i = 0; i < moving; i++)
+			m_Transforms.SetRotation(i * NodesPerSystem, rotation);
+
+		auto start = std::chrono::high_resolution_clock::now();
+		m_UpdatedNodes = m_Transforms.Update();
+		auto end = std::chrono::high_resolution_clock::now();
+		m_UpdateTime = std::chrono::duration<float, std::milli>(end - start).count();
+	}
+
+	void TestTransformHierarchy::OnUpdate(float deltaTime, FramePacket& packet)
+	{
+		OnUpdate(deltaTime);
+
+		std::vector<glm::mat4>& worlds = m_Worlds.Get();
+		worlds.assign(m_Transforms.GetWorldMatrices(), m_Transforms.GetWorldMatrices() + m_Transforms.GetCount());
+		m_Worlds.Submit(packet, [this](const std::vector<glm::mat4>& worlds) { Draw(worlds.data(), (unsigned int)worlds.size()); });
+	}
+
+	void TestTransformHierarchy::OnRender()
+	{
+		Draw(m_Transforms.GetWorldMatrices(), m_Transforms.GetCount());
+	}
+
+	void TestTransformHierarchy::Draw(const glm::mat4* worlds, unsigned int count)
+	{
+		GLCall(glClearColor(0.0f, 0.0f, 0.0f, 1.0f));
+		GLCall(glClear(GL_COLOR_BUFFER_BIT));
+
+		// World matrices already include the size of every node
+		m_Renderer.BeginBatch(*m_Shader, m_Camera);
+		for (unsigned int node = 0; node < count; node++)
+			m_Renderer.DrawQuad(worlds[node], *m_Texture);
+		m_Renderer.EndBatch();
+	}
+
+	void TestTransformHierarchy::OnImGuiRender()
+	{
+		ImGui::SliderInt("Systems", &m_SystemCount, 1, 20000);
+		ImGui::SliderFloat("Moving %", &m_MovingPercent, 0.0f, 100.0f);
+		ImGui::Text("Nodes: %u", m_Transforms.GetCount());
+		ImGui::Text("Updated: %u nodes in %.3f ms", m_UpdatedNodes, m_UpdateTime);
+		ImGui::Text("Application average %.3f ms/frame (%.1f FPS)", 1000.0f / ImGui::GetIO().Framerate, ImGui::GetIO().Framerate);
+	}
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "Test.h"
+
+#include "Renderer.h"
+#include "Texture.h"
+#include "Camera.h"
+#include "TransformHierarchy.h"
+#include "FramePacket.h"
+
+#include <memory>
+#include <vector>
+
+namespace test{
+
+	class TestTransformHierarchy : public Test
+	{
+	public:
+		TestTransformHierarchy();
+		~TestTransformHierarchy();
+
+		void OnUpdate(float deltaTime) override;
+		void OnUpdate(float deltaTime, FramePacket& packet) override;
+		void OnRender() override;
+		void OnImGuiRender() override;
+
+	private:
+		// lays out a grid of systems: a sun with two planets that each have a moon
+		void BuildSystems();
+		void Draw(const glm::mat4* worlds, unsigned int count);
+
+		Renderer m_Renderer;
+
+		std::unique_ptr<Shader> m_Shader;
+		std::unique_ptr<Texture> m_Texture;
+
+		OrthographicCamera m_Camera;
+
+		TransformHierarchy m_Transforms;
+		// world matrices the render thread draws
+		FrameSnapshot<std::vector<glm::mat4>> m_Worlds;
+		int m_SystemCount;
+		int m_BuiltCount;
+		// share of the systems that spin, the rest stay where they are
+		float m_MovingPercent;
+		float m_Angle;
+
+		// what the last Update cost
+		unsigned int m_UpdatedNodes;
+		float m_UpdateTime;
+	};
+}
\ No newline at end of file
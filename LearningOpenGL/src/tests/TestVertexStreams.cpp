@@ -0,0 +1,141 @@
+#include "TestVertexStreams.h"
+
+#include "imgui/imgui.h"
+
+#include "glm/glm.hpp"
+
+#include <chrono>
+#include <cmath>
+
+namespace test {
+
+	TestVertexStreams::TestVertexStreams()
+		: m_Camera(960.0f, 540.0f), m_QuadCount(50000), m_SplitStreams(true), m_Time(0.0f),
+		m_UploadSize(0), m_UploadTime(0.0f)
+	{
+		m_ColorData.resize(MaxQuads * 4);
+
+		// Every quad keeps its color, so the color stream is written once for all of them
+		for (int i = 0; i < MaxQuads; i++)
+		{
+			float hue = i * 0.01f;
+			glm::vec4 color(0.5f + 0.5f * std::sin(hue), 0.5f + 0.5f * std::cos(hue), 1.0f, 1.0f);
+			for (int v = 0; v < 4; v++)
+				m_ColorData[i * 4 + v] = color;
+		}
+
+		m_Positions = std::make_unique<VertexBuffer>(MaxQuads * 4 * (unsigned int)sizeof(glm::vec2), BufferUsage::Stream);
+		m_Colors = std::make_unique<VertexBuffer>(m_ColorData.data(), MaxQuads * 4 * (unsigned int)sizeof(glm::vec4));
+		m_Interleaved = std::make_unique<VertexBuffer>(MaxQuads * 4 * (unsigned int)sizeof(InterleavedVertex), BufferUsage::Stream);
+
+		// Each added buffer continues at the next attribute, position at 0 and color at 1 like Stream.shader reads
+		m_StreamsVAO = std::make_unique<VertexArray>();
+		m_StreamsVAO->AddBuffer(*m_Positions, StaticLayout<Float2>());
+		m_StreamsVAO->AddBuffer(*m_Colors, StaticLayout<Float4>());
+
+		using InterleavedLayout = StaticLayout<Float2, Float4>;
+		static_assert(InterleavedLayout::Stride == sizeof(InterleavedVertex), "InterleavedLayout does not match InterleavedVertex");
+		m_InterleavedVAO = std::make_unique<VertexArray>();
+		m_InterleavedVAO->AddBuffer(*m_Interleaved, InterleavedLayout());
+
+		m_Shader = std::make_unique<Shader>("res/shaders/Stream.shader");
+	}
+
+	TestVertexStreams::~TestVertexStreams()
+	{
+	}
+
+	void TestVertexStreams::OnUpdate(float deltaTime)
+	{
+		m_Time += deltaTime;
+
+		// Only the positions change from frame to frame
+		Streams& streams = m_Streams.Get();
+		std::vector<glm::vec2>& positions = streams.Positions;
+		positions.resize(m_QuadCount * 4);
+		int columns = (int)std::ceil(std::sqrt((float)m_QuadCount));
+		glm::vec2 cell(960.0f / columns, 540.0f / columns);
+		for (int i = 0; i < m_QuadCount; i++)
+		{
+			float phase = m_Time * 2.0f + i * 0.01f;
+			glm::vec2 center((i % columns + 0.5f) * cell.x, (i / columns + 0.5f) * cell.y);
+			glm::vec2 half = cell * (0.3f + 0.15f * std::sin(phase));
+
+			glm::vec2* quad = &positions[i * 4];
+			quad[0] = center + glm::vec2(-half.x, -half.y);
+			quad[1] = center + glm::vec2( half.x, -half.y);
+			quad[2] = center + glm::vec2( half.x,  half.y);
+			quad[3] = center + glm::vec2(-half.x,  half.y);
+		}
+
+		// The unchanged colors travel along with every position
+		if (!m_SplitStreams)
+		{
+			std::vector<InterleavedVertex>& interleaved = streams.Interleaved;
+			interleaved.resize(m_QuadCount * 4);
+			for (int i = 0; i < m_QuadCount * 4; i++)
+				interleaved[i] = { positions[i], m_ColorData[i] };
+		}
+	}
+
+	void TestVertexStreams::OnUpdate(float deltaTime, FramePacket& packet)
+	{
+		OnUpdate(deltaTime);
+
+		int quadCount = m_QuadCount;
+		bool splitStreams = m_SplitStreams;
+		m_Streams.Submit(packet, [this, quadCount, splitStreams](const Streams& streams)
+		{
+			Draw(streams, quadCount, splitStreams);
+		});
+	}
+
+	void TestVertexStreams::OnRender()
+	{
+		Draw(m_Streams.Get(), m_QuadCount, m_SplitStreams);
+	}
+
+	void TestVertexStreams::Draw(const Streams& streams, int quadCount, bool splitStreams)
+	{
+		GLCall(glClearColor(0.0f, 0.0f, 0.0f, 1.0f));
+		GLCall(glClear(GL_COLOR_BUFFER_BIT));
+
+		unsigned int vertexCount = quadCount * 4;
+		unsigned int uploadSize;
+		auto start = std::chrono::high_resolution_clock::now();
+		if (splitStreams)
+		{
+			// the color buffer is left alone
+			uploadSize = vertexCount * (unsigned int)sizeof(glm::vec2);
+			m_Positions->SetSubData(streams.Positions.data(), uploadSize, 0, BufferUpdate::Orphan);
+		}
+		else
+		{
+			uploadSize = vertexCount * (unsigned int)sizeof(InterleavedVertex);
+			m_Interleaved->SetSubData(streams.Interleaved.data(), uploadSize, 0, BufferUpdate::Orphan);
+		}
+		auto end = std::chrono::high_resolution_clock::now();
+		float uploadTime = std::chrono::duration<float, std::milli>(end - start).count();
+		float averageTime = m_UploadTime.load();
+		m_UploadTime.store(averageTime + (uploadTime - averageTime) * 0.1f);
+		m_UploadSize.store(uploadSize);
+
+		m_Shader->Bind();
+		m_Shader->SetUniformMat4f("u_ViewProj", m_Camera.GetViewProjection());
+		if (splitStreams)
+			m_StreamsVAO->Bind();
+		else
+			m_InterleavedVAO->Bind();
+		const IndexBuffer& indices = QuadIndexBuffer::Get(quadCount);
+		indices.Bind();
+		GLCall(glDrawElements(GL_TRIANGLES, quadCount * 6, indices.GetType(), nullptr));
+	}
+
+	void TestVertexStreams::OnImGuiRender()
+	{
+		ImGui::SliderInt("Quads", &m_QuadCount, 1, MaxQuads);
+		ImGui::Checkbox("Separate position and color streams", &m_SplitStreams);
+		ImGui::Text("%.2f MB per frame, upload %.3f ms", m_UploadSize.load() / (1024.0f * 1024.0f), m_UploadTime.load());
+		ImGui::Text("Application average %.3f ms/frame (%.1f FPS)", 1000.0f / ImGui::GetIO().Framerate, ImGui::GetIO().Framerate);
+	}
+}
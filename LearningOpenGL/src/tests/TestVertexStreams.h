@@ -0,0 +1,74 @@
+#pragma once
+
+#include "Test.h"
+
+#include "Renderer.h"
+#include "VertexBuffer.h"
+#include "StaticLayout.h"
+#include "QuadIndexBuffer.h"
+#include "Camera.h"
+#include "FramePacket.h"
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace test{
+
+	// Quads whose positions move every frame while their colors never change, uploaded either as one
+	// interleaved buffer or as two streams of one vertex array where only the positions are rewritten
+	class TestVertexStreams : public Test
+	{
+	public:
+		TestVertexStreams();
+		~TestVertexStreams();
+
+		void OnUpdate(float deltaTime) override;
+		void OnUpdate(float deltaTime, FramePacket& packet) override;
+		void OnRender() override;
+		void OnImGuiRender() override;
+
+	private:
+		struct InterleavedVertex
+		{
+			glm::vec2 Position;
+			glm::vec4 Color;
+		};
+
+		// the vertex data OnUpdate animates for one frame
+		struct Streams
+		{
+			std::vector<glm::vec2> Positions;
+			// only filled when the streams are not split
+			std::vector<InterleavedVertex> Interleaved;
+		};
+
+		static const int MaxQuads = 100000;
+
+		void Draw(const Streams& streams, int quadCount, bool splitStreams);
+
+		// rewritten every frame
+		std::unique_ptr<VertexBuffer> m_Positions;
+		// uploaded once
+		std::unique_ptr<VertexBuffer> m_Colors;
+		std::unique_ptr<VertexBuffer> m_Interleaved;
+		// attributes 0 and 1 come from two buffers
+		std::unique_ptr<VertexArray> m_StreamsVAO;
+		std::unique_ptr<VertexArray> m_InterleavedVAO;
+		std::unique_ptr<Shader> m_Shader;
+
+		OrthographicCamera m_Camera;
+
+		// animated on the main thread, uploaded by the render thread
+		FrameSnapshot<Streams> m_Streams;
+		std::vector<glm::vec4> m_ColorData;
+
+		int m_QuadCount;
+		bool m_SplitStreams;
+		float m_Time;
+
+		// bytes sent by the last upload and its CPU time, averaged over a few frames, written while drawing
+		std::atomic<unsigned int> m_UploadSize;
+		std::atomic<float> m_UploadTime;
+	};
+}
\ No newline at end of file